@@ -12,6 +12,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_histories.h"
 #include "data/data_message_reaction_id.h"
 #include "data/data_peer.h"
+#include "data/data_search_index.h"
 #include "data/data_session.h"
 #include "history/history.h"
 #include "history/history_item.h"
@@ -75,6 +76,22 @@ MessagesSearch::~MessagesSearch() {
 void MessagesSearch::searchMessages(Request request) {
 	_request = std::move(request);
 	_offsetId = {};
+
+	// Show results from the local index right away, the server reply
+	// replaces them when (and if) it arrives.
+	if (!_request.from && _request.tags.empty()) {
+		auto local = _history->owner().searchIndex().query(
+			_history->peer->id,
+			_request.query,
+			kSearchPerPage);
+		if (!local.empty()) {
+			_messagesFounds.fire({
+				int(local.size()),
+				std::move(local),
+				RequestToToken(_request),
+			});
+		}
+	}
 	searchRequest();
 }
 
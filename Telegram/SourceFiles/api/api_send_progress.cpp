@@ -22,6 +22,8 @@ constexpr auto kCancelTypingActionTimeout = crl::time(5000);
 constexpr auto kSendMySpeakingInterval = 3 * crl::time(1000);
 constexpr auto kSendMyTypingInterval = 5 * crl::time(1000);
 constexpr auto kSendTypingsToOfflineFor = TimeId(30);
+constexpr auto kSlowRoundTripThreshold = crl::time(1000);
+constexpr auto kMaxIntervalBackoff = 3;
 
 } // namespace
 
@@ -42,7 +44,11 @@ void SendProgressManager::cancel(
 		SendProgressType type) {
 	const auto i = _requests.find(Key{ history, topMsgId, type });
 	if (i != _requests.end()) {
-		_session->api().request(i->second).cancel();
+		// A request still pending after a whole resend interval means the
+		// link is congested - count it against the send frequency, but a
+		// quickly cancelled one says nothing about the round trip time.
+		registerRoundTrip(crl::now() - i->second.sent, false);
+		_session->api().request(i->second.id).cancel();
 		_requests.erase(i);
 	}
 }
@@ -86,9 +92,12 @@ bool SendProgressManager::updated(const Key &key, bool doing) {
 	const auto now = crl::now();
 	const auto i = _updated.find(key);
 	if (doing) {
-		const auto sendEach = (key.type == SendProgressType::Speaking)
+		// Status updates are pure overhead on a congested link, so widen
+		// the resend interval while the setTyping round trips come back
+		// slow and narrow it again once they turn fast.
+		const auto sendEach = ((key.type == SendProgressType::Speaking)
 			? kSendMySpeakingInterval
-			: kSendMyTypingInterval;
+			: kSendMyTypingInterval) << _intervalBackoff;
 		if (i == end(_updated)) {
 			_updated.emplace(key, now + 2 * sendEach);
 		} else if (i->second > now + sendEach) {
@@ -143,7 +152,7 @@ void SendProgressManager::send(const Key &key, int progress) {
 	)).done([=](const MTPBool &result, mtpRequestId requestId) {
 		done(requestId);
 	}).send();
-	_requests.emplace(key, requestId);
+	_requests.emplace(key, Request{ requestId, crl::now() });
 
 	if (key.type == Type::Typing) {
 		_stopTypingHistory = key.history;
@@ -172,11 +181,22 @@ bool SendProgressManager::skipRequest(const Key &key) const {
 
 void SendProgressManager::done(mtpRequestId requestId) {
 	for (auto i = _requests.begin(), e = _requests.end(); i != e; ++i) {
-		if (i->second == requestId) {
+		if (i->second.id == requestId) {
+			registerRoundTrip(crl::now() - i->second.sent, true);
 			_requests.erase(i);
 			break;
 		}
 	}
 }
 
+void SendProgressManager::registerRoundTrip(
+		crl::time elapsed,
+		bool completed) {
+	if (elapsed >= kSlowRoundTripThreshold) {
+		_intervalBackoff = std::min(_intervalBackoff + 1, kMaxIntervalBackoff);
+	} else if (completed && _intervalBackoff > 0) {
+		--_intervalBackoff;
+	}
+}
+
 } // namespace Api
@@ -87,16 +87,23 @@ private:
 		}
 	};
 
+	struct Request {
+		mtpRequestId id = 0;
+		crl::time sent = 0;
+	};
+
 	bool updated(const Key &key, bool doing);
 
 	void send(const Key &key, int progress);
 	void done(mtpRequestId requestId);
+	void registerRoundTrip(crl::time elapsed, bool completed);
 
 	[[nodiscard]] bool skipRequest(const Key &key) const;
 
 	const not_null<Main::Session*> _session;
-	base::flat_map<Key, mtpRequestId> _requests;
+	base::flat_map<Key, Request> _requests;
 	base::flat_map<Key, crl::time> _updated;
+	int _intervalBackoff = 0;
 	base::Timer _stopTypingTimer;
 	History *_stopTypingHistory = nullptr;
 
@@ -164,10 +164,13 @@ MTPVector<MTPMessageEntity> EntitiesToMTP(
 				if (trimmed.isEmpty()) {
 					return MTP_inputUserEmpty();
 				}
-				auto regex = QRegularExpression(
-					QString::fromUtf8("^(?i)tg://user\\?(.+)"),
-					QRegularExpression::UseUnicodePropertiesOption);
-				regex.optimize();
+				static const auto regex = [] {
+					auto result = QRegularExpression(
+						QString::fromUtf8("^(?i)tg://user\\?(.+)"),
+						QRegularExpression::UseUnicodePropertiesOption);
+					result.optimize();
+					return result;
+				}();
 				const auto match = regex.match(trimmed);
 				if (!match.hasMatch() || match.capturedStart() != 0) {
 					return MTP_inputUserEmpty();
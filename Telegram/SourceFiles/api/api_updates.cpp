@@ -17,6 +17,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "api/api_transcribes.h"
 #include "main/main_session.h"
 #include "main/main_account.h"
+#include "main/main_domain.h"
 #include "mtproto/mtp_instance.h"
 #include "mtproto/mtproto_config.h"
 #include "mtproto/mtproto_dc_options.h"
@@ -75,6 +76,12 @@ constexpr auto kNoUpdatesTimeout = 60 * 1000;
 // If nothing is received in 1 min when was a sleepmode we ping.
 constexpr auto kNoUpdatesAfterSleepTimeout = 60 * crl::time(1000);
 
+// How often we log the per-account update processing time split.
+constexpr auto kProcessingTimeLogInterval = 60 * crl::time(1000);
+
+// Difference slices applied longer than this get logged with counts.
+constexpr auto kSlowDifferenceSliceDuration = crl::time(100);
+
 enum class DataIsLoadedResult {
 	NotLoaded = 0,
 	FromNotLoaded = 1,
@@ -288,12 +295,22 @@ void Updates::checkLastUpdate(bool afterSleep) {
 	const auto skip = afterSleep
 		? kNoUpdatesAfterSleepTimeout
 		: kNoUpdatesTimeout;
+	if (afterSleep && !_resumeWaitingSince) {
+		_resumeWaitingSince = now;
+	}
 	if (_lastUpdateTime && now > _lastUpdateTime + skip) {
 		_lastUpdateTime = now;
 		sendPing();
 	}
 }
 
+void Updates::reportFirstUpdateAfterWake() {
+	if (const auto since = base::take(_resumeWaitingSince)) {
+		DEBUG_LOG(("Updates: First update %1ms after wake."
+			).arg(crl::now() - since));
+	}
+}
+
 void Updates::feedUpdateVector(
 		const MTPVector<MTPUpdate> &updates,
 		SkipUpdatePolicy policy) {
@@ -454,6 +471,7 @@ void Updates::stateDone(const MTPupdates_State &state) {
 	const auto &d = state.c_updates_state();
 	setState(d.vpts().v, d.vdate().v, d.vqts().v, d.vseq().v);
 
+	reportFirstUpdateAfterWake();
 	_lastUpdateTime = crl::now();
 	_noUpdatesTimer.callOnce(kNoUpdatesTimeout);
 	_ptsWaiter.setRequesting(false);
@@ -592,11 +610,22 @@ void Updates::feedDifference(
 		const MTPVector<MTPMessage> &msgs,
 		const MTPVector<MTPUpdate> &other) {
 	Core::App().checkAutoLock();
+	const auto start = crl::now();
 	session().data().processUsers(users);
 	session().data().processChats(chats);
 	feedMessageIds(other);
 	session().data().processMessages(msgs, NewMessageType::Unread);
 	feedUpdateVector(other, SkipUpdatePolicy::SkipMessageIds);
+	const auto elapsed = crl::now() - start;
+	if (elapsed >= kSlowDifferenceSliceDuration) {
+		DEBUG_LOG(("Updates: Difference slice with %1 users, %2 chats, "
+			"%3 messages and %4 other updates applied in %5ms."
+			).arg(users.v.size()
+			).arg(chats.v.size()
+			).arg(msgs.v.size()
+			).arg(other.v.size()
+			).arg(elapsed));
+	}
 }
 
 void Updates::differenceFail(const MTP::Error &error) {
@@ -850,16 +879,41 @@ void Updates::mtpNewSessionCreated() {
 
 void Updates::mtpUpdateReceived(const MTPUpdates &updates) {
 	Core::App().checkAutoLock();
+	reportFirstUpdateAfterWake();
 	_lastUpdateTime = crl::now();
 	_noUpdatesTimer.callOnce(kNoUpdatesTimeout);
 	if (!requestingDifference()
 		|| HasForceLogoutNotification(updates)) {
+		const auto start = crl::now();
 		applyUpdates(updates);
+		accumulateProcessingTime(crl::now() - start);
 	} else {
 		applyGroupCallParticipantUpdates(updates);
 	}
 }
 
+void Updates::accumulateProcessingTime(crl::time elapsed) {
+	// With several accounts every update is applied on the same main
+	// thread, so surface the per-account split - a storm on a background
+	// account janking the active chat shows up right in the log.
+	_processingTime += elapsed;
+	const auto now = crl::now();
+	if (!_processingTimeLoggedAt) {
+		_processingTimeLoggedAt = now;
+	} else if (now - _processingTimeLoggedAt >= kProcessingTimeLogInterval) {
+		const auto background
+			= (&_session->account() != &Core::App().domain().active());
+		DEBUG_LOG(("Updates: %1 account %2 spent %3ms applying updates "
+			"in the last %4s."
+			).arg(background ? u"Background"_q : u"Active"_q
+			).arg(_session->userId().bare
+			).arg(_processingTime
+			).arg((now - _processingTimeLoggedAt) / 1000));
+		_processingTimeLoggedAt = now;
+		_processingTime = 0;
+	}
+}
+
 void Updates::applyGroupCallParticipantUpdates(const MTPUpdates &updates) {
 	updates.match([&](const MTPDupdates &data) {
 		session().data().processUsers(data.vusers());
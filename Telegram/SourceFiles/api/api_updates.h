@@ -121,6 +121,8 @@ private:
 	void feedChannelDifference(const MTPDupdates_channelDifference &data);
 
 	void mtpUpdateReceived(const MTPUpdates &updates);
+	void accumulateProcessingTime(crl::time elapsed);
+	void reportFirstUpdateAfterWake();
 	void mtpNewSessionCreated();
 	void feedUpdateVector(
 		const MTPVector<MTPUpdate> &updates,
@@ -194,6 +196,9 @@ private:
 		mtpRequestId> _rangeDifferenceRequests;
 
 	crl::time _lastUpdateTime = 0;
+	crl::time _resumeWaitingSince = 0;
+	crl::time _processingTime = 0;
+	crl::time _processingTimeLoggedAt = 0;
 	bool _handlingChannelDifference = false;
 
 	base::flat_map<int, ActiveChatTracker> _activeChats;
@@ -98,6 +98,7 @@ constexpr auto kReadFeaturedSetsTimeout = crl::time(1000);
 constexpr auto kFileLoaderQueueStopTimeout = crl::time(5000);
 constexpr auto kStickersByEmojiInvalidateTimeout = crl::time(6 * 1000);
 constexpr auto kNotifySettingSaveTimeout = crl::time(1000);
+constexpr auto kMarkContentsReadTimeout = crl::time(1000);
 constexpr auto kDialogsFirstLoad = 20;
 constexpr auto kDialogsPerPage = 500;
 constexpr auto kStatsSessionKillTimeout = 10 * crl::time(1000);
@@ -155,6 +156,7 @@ ApiWrap::ApiWrap(not_null<Main::Session*> session)
 , _fileLoader(std::make_unique<TaskQueue>(kFileLoaderQueueStopTimeout))
 , _topPromotionTimer([=] { refreshTopPromotion(); })
 , _updateNotifyTimer([=] { sendNotifySettingsUpdates(); })
+, _contentsReadTimer([=] { sendMarkedContentsRead(); })
 , _statsSessionKillTimer([=] { checkStatsSessions(); })
 , _authorizations(std::make_unique<Api::Authorizations>(this))
 , _attachedStickers(std::make_unique<Api::AttachedStickers>(this))
@@ -1328,33 +1330,8 @@ void ApiWrap::migrateFail(not_null<PeerData*> peer, const QString &error) {
 
 void ApiWrap::markContentsRead(
 		const base::flat_set<not_null<HistoryItem*>> &items) {
-	auto markedIds = QVector<MTPint>();
-	auto channelMarkedIds = base::flat_map<
-		not_null<ChannelData*>,
-		QVector<MTPint>>();
-	markedIds.reserve(items.size());
 	for (const auto &item : items) {
-		if (!item->markContentsRead(true) || !item->isRegular()) {
-			continue;
-		}
-		if (const auto channel = item->history()->peer->asChannel()) {
-			channelMarkedIds[channel].push_back(MTP_int(item->id));
-		} else {
-			markedIds.push_back(MTP_int(item->id));
-		}
-	}
-	if (!markedIds.isEmpty()) {
-		request(MTPmessages_ReadMessageContents(
-			MTP_vector<MTPint>(markedIds)
-		)).done([=](const MTPmessages_AffectedMessages &result) {
-			applyAffectedMessages(result);
-		}).send();
-	}
-	for (const auto &channelIds : channelMarkedIds) {
-		request(MTPchannels_ReadMessageContents(
-			channelIds.first->inputChannel,
-			MTP_vector<MTPint>(channelIds.second)
-		)).send();
+		markContentsRead(item);
 	}
 }
 
@@ -1362,19 +1339,33 @@ void ApiWrap::markContentsRead(not_null<HistoryItem*> item) {
 	if (!item->markContentsRead(true) || !item->isRegular()) {
 		return;
 	}
-	const auto ids = MTP_vector<MTPint>(1, MTP_int(item->id));
+	// The ids are accumulated while the user scrolls and flushed in one
+	// request per peer, otherwise every paint pass revealing a voice
+	// message or a mention spawns its own acknowledgement request.
 	if (const auto channel = item->history()->peer->asChannel()) {
-		request(MTPchannels_ReadMessageContents(
-			channel->inputChannel,
-			ids
-		)).send();
+		_contentsReadChannelIds[channel].push_back(MTP_int(item->id));
 	} else {
+		_contentsReadIds.push_back(MTP_int(item->id));
+	}
+	if (!_contentsReadTimer.isActive()) {
+		_contentsReadTimer.callOnce(kMarkContentsReadTimeout);
+	}
+}
+
+void ApiWrap::sendMarkedContentsRead() {
+	if (!_contentsReadIds.isEmpty()) {
 		request(MTPmessages_ReadMessageContents(
-			ids
+			MTP_vector<MTPint>(base::take(_contentsReadIds))
 		)).done([=](const MTPmessages_AffectedMessages &result) {
 			applyAffectedMessages(result);
 		}).send();
 	}
+	for (const auto &[channel, ids] : base::take(_contentsReadChannelIds)) {
+		request(MTPchannels_ReadMessageContents(
+			channel->inputChannel,
+			MTP_vector<MTPint>(ids)
+		)).send();
+	}
 }
 
 void ApiWrap::deleteAllFromParticipant(
@@ -1418,15 +1409,24 @@ void ApiWrap::scheduleStickerSetRequest(uint64 setId, uint64 access) {
 }
 
 void ApiWrap::requestStickerSets() {
+	const auto &sets = _session->data().stickers().sets();
 	for (auto &[id, info] : _stickerSetRequests) {
 		if (info.id) {
 			continue;
 		}
+		// Sets are persisted locally together with the server hash, so
+		// pass it for a cheap stickerSetNotModified when nothing changed.
+		const auto i = sets.find(id);
+		const auto hash = (i != sets.end()
+			&& !(i->second->flags & Data::StickersSetFlag::NotLoaded)
+			&& !i->second->stickers.empty())
+			? int32(i->second->hash)
+			: 0;
 		info.id = request(MTPmessages_GetStickerSet(
 			MTP_inputStickerSetID(
 				MTP_long(id),
 				MTP_long(info.accessHash)),
-			MTP_int(0) // hash
+			MTP_int(hash)
 		)).done([=, setId = id](const MTPmessages_StickerSet &result) {
 			gotStickerSet(setId, result);
 		}).fail([=, setId = id] {
@@ -2246,7 +2246,7 @@ void ApiWrap::gotStickerSet(
 	result.match([&](const MTPDmessages_stickerSet &data) {
 		_session->data().stickers().feedSetFull(data);
 	}, [](const MTPDmessages_stickerSetNotModified &) {
-		LOG(("API Error: Unexpected messages.stickerSetNotModified."));
+		// The locally persisted copy is still current.
 	});
 }
 
@@ -2981,6 +2981,18 @@ void ApiWrap::requestMessageAfterDate(
 	const auto minId = 0;
 	const auto historyHash = uint64(0);
 
+	// If the loaded part of the history already covers the target date,
+	// resolve the jump locally without a server round trip.
+	if (!topicRootId) {
+		if (const auto history = _session->data().historyLoaded(peer)) {
+			const auto id = history->findMessageIdAfterDate(offsetDate + 1);
+			if (id) {
+				callback(id);
+				return;
+			}
+		}
+	}
+
 	auto send = [&](auto &&serialized) {
 		request(std::move(serialized)).done([
 			=,
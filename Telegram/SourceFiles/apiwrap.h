@@ -548,6 +548,7 @@ private:
 	void topPromotionDone(const MTPhelp_PromoData &proxy);
 
 	void sendNotifySettingsUpdates();
+	void sendMarkedContentsRead();
 
 	template <typename Request>
 	void requestFileReference(
@@ -673,6 +674,12 @@ private:
 	base::Timer _updateNotifyTimer;
 	rpl::lifetime _updateNotifyQueueLifetime;
 
+	QVector<MTPint> _contentsReadIds;
+	base::flat_map<
+		not_null<ChannelData*>,
+		QVector<MTPint>> _contentsReadChannelIds;
+	base::Timer _contentsReadTimer;
+
 	std::map<
 		Data::FileOrigin,
 		std::vector<FileReferencesHandler>> _fileReferenceHandlers;
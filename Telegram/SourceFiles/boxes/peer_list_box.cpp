@@ -552,6 +552,10 @@ void PeerListRow::preloadUserpic() {
 	}
 }
 
+void PeerListRow::clearUserpicCache() {
+	_userpic = {};
+}
+
 void PeerListRow::setCustomStatus(const QString &status, bool active) {
 	setStatusText(status);
 	_statusType = active ? StatusType::CustomActive : StatusType::Custom;
@@ -1945,7 +1949,28 @@ void PeerListContent::loadProfilePhotos() {
 			for (auto index = from; index != to; ++index) {
 				getRow(RowIndex(index))->preloadUserpic();
 			}
+			clearDistantUserpicCaches(from, to);
+		}
+	}
+}
+
+void PeerListContent::clearDistantUserpicCaches(int from, int till) {
+	// Each painted row keeps its rounded userpic frame alive, which adds
+	// up to hundreds of megabytes when tens of thousands of members get
+	// scrolled through, so drop the frames of rows left far behind.
+	const auto keepFrom = std::max(from - (till - from), 0);
+	if (_userpicsCacheFrom == keepFrom && _userpicsCacheTill == till) {
+		return;
+	}
+	_userpicsCacheFrom = keepFrom;
+	_userpicsCacheTill = till;
+	const auto rowsCount = shownRowsCount();
+	for (auto index = 0; index != rowsCount; ++index) {
+		if (index >= keepFrom && index < till) {
+			index = till - 1;
+			continue;
 		}
+		getRow(RowIndex(index))->clearUserpicCache();
 	}
 }
 
@@ -2223,6 +2248,31 @@ void PeerListContent::updateRow(RowIndex index) {
 	update(0, getRowTop(index), width(), _rowHeight);
 }
 
+void PeerListContent::updateRows(
+		const base::flat_set<not_null<PeerListRow*>> &rows) {
+	// Repaint-only version of updateRow for a whole set at once. The
+	// speaking-level animation in large group calls touches dozens of
+	// rows each frame, one union rectangle beats one update() per row.
+	auto from = -1;
+	auto till = -1;
+	for (const auto &row : rows) {
+		const auto index = findRowIndex(row).value;
+		if (index < 0) {
+			continue;
+		}
+		if (from < 0 || index < from) {
+			from = index;
+		}
+		if (index >= till) {
+			till = index + 1;
+		}
+	}
+	if (from >= 0) {
+		const auto top = getRowTop(RowIndex(from));
+		update(0, top, width(), (till - from) * _rowHeight);
+	}
+}
+
 template <typename Callback>
 bool PeerListContent::enumerateShownRows(Callback callback) {
 	return enumerateShownRows(0, shownRowsCount(), std::move(callback));
@@ -102,6 +102,7 @@ public:
 		-> const base::flat_set<QString> &;
 
 	virtual void preloadUserpic();
+	void clearUserpicCache();
 
 	void setCustomStatus(const QString &status, bool active = false);
 	void clearCustomStatus();
@@ -318,6 +319,8 @@ public:
 	virtual void peerListPrependRow(std::unique_ptr<PeerListRow> row) = 0;
 	virtual void peerListPrependRowFromSearchResult(not_null<PeerListRow*> row) = 0;
 	virtual void peerListUpdateRow(not_null<PeerListRow*> row) = 0;
+	virtual void peerListUpdateRows(
+		const base::flat_set<not_null<PeerListRow*>> &rows) = 0;
 	virtual void peerListRemoveRow(not_null<PeerListRow*> row) = 0;
 	virtual void peerListConvertRowToSearchResult(not_null<PeerListRow*> row) = 0;
 	virtual bool peerListIsRowChecked(not_null<PeerListRow*> row) = 0;
@@ -625,6 +628,7 @@ public:
 	void updateRow(not_null<PeerListRow*> row) {
 		updateRow(row, RowIndex());
 	}
+	void updateRows(const base::flat_set<not_null<PeerListRow*>> &rows);
 	void removeRow(not_null<PeerListRow*> row);
 	void convertRowToSearchResult(not_null<PeerListRow*> row);
 	int fullRowsCount() const;
@@ -751,6 +755,7 @@ private:
 
 	void selectByMouse(QPoint globalPosition);
 	void loadProfilePhotos();
+	void clearDistantUserpicCaches(int from, int till);
 	void checkScrollForPreload();
 
 	void updateRow(not_null<PeerListRow*> row, RowIndex hint);
@@ -807,6 +812,8 @@ private:
 	int _rowHeight = 0;
 	int _visibleTop = 0;
 	int _visibleBottom = 0;
+	int _userpicsCacheFrom = 0;
+	int _userpicsCacheTill = 0;
 
 	Selected _selected;
 	Selected _pressed;
@@ -884,6 +891,10 @@ public:
 	void peerListUpdateRow(not_null<PeerListRow*> row) override {
 		_content->updateRow(row);
 	}
+	void peerListUpdateRows(
+			const base::flat_set<not_null<PeerListRow*>> &rows) override {
+		_content->updateRows(rows);
+	}
 	void peerListRemoveRow(not_null<PeerListRow*> row) override {
 		_content->removeRow(row);
 	}
@@ -928,6 +928,10 @@ void Call::createAndStartController(const MTPDphoneCall &call) {
 		});
 	};
 
+	// Video codec and encoder selection (including any hardware encode
+	// via VAAPI / NVENC / QSV) happens inside tgcalls and its webrtc
+	// backend, a preference toggle would have to thread through this
+	// Config once the library exposes such a knob.
 	tgcalls::Descriptor descriptor = {
 		.version = versionString,
 		.config = tgcalls::Config{
@@ -46,6 +46,11 @@ namespace {
 
 constexpr auto kKeepRaisedHandStatusDuration = 3 * crl::time(1000);
 
+// Creating a row is not free (userpic view, text shaping), a several
+// thousand participants call stalls the join for seconds if all rows
+// appear at once, so append them in batches of this size.
+constexpr auto kPrepareRowsPerBatch = 200;
+
 using Row = MembersRow;
 
 } // namespace
@@ -111,6 +116,7 @@ private:
 
 	[[nodiscard]] bool isMe(not_null<PeerData*> participantPeer) const;
 	void prepareRows(not_null<Data::GroupCall*> real);
+	void schedulePrepareRows();
 
 	[[nodiscard]] base::unique_qptr<Ui::PopupMenu> createRowContextMenu(
 		QWidget *parent,
@@ -174,6 +180,7 @@ private:
 	not_null<PeerData*> _peer;
 	std::string _largeEndpoint;
 	bool _prepared = false;
+	bool _prepareRowsScheduled = false;
 
 	rpl::event_stream<MuteRequest> _toggleMuteRequests;
 	rpl::event_stream<VolumeRequest> _changeVolumeRequests;
@@ -262,10 +269,14 @@ Members::Controller::Controller(
 			_soundingAnimation.stop();
 			return false;
 		}
+		auto animated = base::flat_set<not_null<PeerListRow*>>();
+		animated.reserve(_soundingRowBySsrc.size());
 		for (const auto &[ssrc, row] : _soundingRowBySsrc) {
 			row->updateBlobAnimation(now);
-			delegate()->peerListUpdateRow(row);
+			animated.emplace(row);
 		}
+		// One union repaint per frame instead of one update per row.
+		delegate()->peerListUpdateRows(animated);
 		return true;
 	});
 
@@ -856,10 +867,14 @@ void Members::Controller::prepareRows(not_null<Data::GroupCall*> real) {
 	auto foundMe = false;
 	auto changed = false;
 	auto count = delegate()->peerListFullRowsCount();
+
+	// Every existing row either gets re-added to the sounding map in
+	// the loop below or is removed from the list, so just clear the
+	// map once instead of linearly scanning it for each row.
+	_soundingRowBySsrc.clear();
 	for (auto i = 0; i != count;) {
 		const auto row = static_cast<Row*>(
 			delegate()->peerListRowAt(i).get());
-		removeRowFromSoundingMap(row);
 		const auto participantPeer = row->peer();
 		const auto me = isMe(participantPeer);
 		if (me) {
@@ -887,10 +902,22 @@ void Members::Controller::prepareRows(not_null<Data::GroupCall*> real) {
 			delegate()->peerListAppendRow(std::move(row));
 		}
 	}
+	auto appended = 0;
 	for (const auto &participant : real->participants()) {
-		if (auto row = createRow(participant)) {
+		if (findRow(participant.peer)) {
+			// The row is still valid, only newly added participants
+			// need a fresh row - updates come through the delta in
+			// participantUpdated().
+			continue;
+		} else if (auto row = createRow(participant)) {
 			changed = true;
 			delegate()->peerListAppendRow(std::move(row));
+			if (++appended >= kPrepareRowsPerBatch) {
+				// Rows below the first screens can wait, let the panel
+				// show up and hydrate the rest on the next iterations.
+				schedulePrepareRows();
+				break;
+			}
 		}
 	}
 	if (changed) {
@@ -898,6 +925,19 @@ void Members::Controller::prepareRows(not_null<Data::GroupCall*> real) {
 	}
 }
 
+void Members::Controller::schedulePrepareRows() {
+	if (_prepareRowsScheduled) {
+		return;
+	}
+	_prepareRowsScheduled = true;
+	crl::on_main(this, [=] {
+		_prepareRowsScheduled = false;
+		if (const auto real = _call->lookupReal()) {
+			prepareRows(real);
+		}
+	});
+}
+
 void Members::Controller::loadMoreRows() {
 	if (const auto real = _call->lookupReal()) {
 		real->requestParticipants();
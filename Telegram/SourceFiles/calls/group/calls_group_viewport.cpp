@@ -247,6 +247,16 @@ void Viewport::add(
 		[=] { widget()->update(); },
 		self));
 
+	const auto tile = _tiles.back().get();
+	tile->track()->renderNextFrame(
+	) | rpl::start_with_next([=] {
+		if (tile->visible()) {
+			widget()->update(tile->geometry());
+		} else {
+			widget()->update();
+		}
+	}, tile->lifetime());
+
 	_tiles.back()->trackSizeValue(
 	) | rpl::filter([](QSize size) {
 		return !size.isEmpty();
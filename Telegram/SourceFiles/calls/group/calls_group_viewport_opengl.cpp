@@ -18,6 +18,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_peer.h"
 #include "styles/style_calls.h"
 
+#include <QOpenGLContext>
 #include <QOpenGLShader>
 
 namespace Calls::Group {
@@ -320,6 +321,20 @@ void Viewport::RendererGL::init(
 	_frameBuffer->create();
 	_frameBuffer->bind();
 	_frameBuffer->allocate(kValues * sizeof(GLfloat));
+
+	// Stream frame uploads through a pixel-unpack buffer, so that the
+	// driver can transfer the data to the texture asynchronously
+	// instead of stalling inside glTexSubImage2D. True zero-copy
+	// (DMA-BUF / EGLImage import) would require the decoded frames to
+	// reach us as GPU handles, while webrtc hands them over as
+	// CPU-side planes.
+	if (!QOpenGLContext::currentContext()->isOpenGLES()) {
+		_uploadBuffer.emplace(QOpenGLBuffer::PixelUnpackBuffer);
+		_uploadBuffer->setUsagePattern(QOpenGLBuffer::StreamDraw);
+		_uploadBuffer->create();
+		_uploadBufferSize = 0;
+	}
+
 	_downscaleProgram.yuv420.emplace();
 	_downscaleVertexShader = LinkProgram(
 		&*_downscaleProgram.yuv420,
@@ -393,6 +408,8 @@ void Viewport::RendererGL::deinit(
 		not_null<QOpenGLWidget*> widget,
 		QOpenGLFunctions *f) {
 	_frameBuffer = std::nullopt;
+	_uploadBuffer = std::nullopt;
+	_uploadBufferSize = 0;
 	_frameVertexShader = nullptr;
 	_imageProgram = std::nullopt;
 	_downscaleProgram.argb32 = std::nullopt;
@@ -1040,7 +1057,21 @@ void Viewport::RendererGL::uploadTexture(
 		QSize size,
 		QSize hasSize,
 		int stride,
-		const void *data) const {
+		const void *data) {
+	const auto perPixel = (format == GL_ALPHA) ? 1 : 4;
+	const auto bytes = stride * perPixel * size.height();
+	const auto streamed = _uploadBuffer && (bytes > 0);
+	if (streamed) {
+		_uploadBuffer->bind();
+		if (_uploadBufferSize < bytes) {
+			_uploadBufferSize = bytes;
+		}
+		// Orphan the previous contents, the GPU may still be reading
+		// them for the last texture update.
+		_uploadBuffer->allocate(_uploadBufferSize);
+		_uploadBuffer->write(0, data, bytes);
+		data = nullptr;
+	}
 	f.glPixelStorei(GL_UNPACK_ROW_LENGTH, stride);
 	if (hasSize != size) {
 		f.glTexImage2D(
@@ -1066,6 +1097,9 @@ void Viewport::RendererGL::uploadTexture(
 			data);
 	}
 	f.glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	if (streamed) {
+		_uploadBuffer->release();
+	}
 }
 
 void Viewport::RendererGL::drawDownscalePass(
@@ -116,7 +116,7 @@ private:
 		QSize size,
 		QSize hasSize,
 		int stride,
-		const void *data) const;
+		const void *data);
 
 	[[nodiscard]] bool isExpanded(
 		not_null<VideoTile*> tile,
@@ -135,6 +135,8 @@ private:
 	bool _rgbaFrame = false;
 	bool _userpicFrame;
 	std::optional<QOpenGLBuffer> _frameBuffer;
+	std::optional<QOpenGLBuffer> _uploadBuffer;
+	int _uploadBufferSize = 0;
 	Program _downscaleProgram;
 	std::optional<QOpenGLShaderProgram> _blurProgram;
 	Program _frameProgram;
@@ -10,6 +10,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "calls/group/calls_group_common.h"
 #include "calls/group/calls_group_viewport_tile.h"
 #include "calls/group/calls_group_members_row.h"
+#include "kotato/kotato_settings.h"
 #include "data/data_peer.h"
 #include "media/view/media_view_pip.h"
 #include "webrtc/webrtc_video_track.h"
@@ -40,6 +41,9 @@ void Viewport::RendererSW::paintFallback(
 		Painter &&p,
 		const QRegion &clip,
 		Ui::GL::Backend backend) {
+	const auto overlay = ::Kotato::JsonSettings::GetBool(
+		"calls_frame_time_overlay");
+	const auto started = overlay ? crl::now() : 0;
 	auto bg = clip;
 	auto hq = PainterHighQualityEnabler(p);
 	const auto bounding = clip.boundingRect();
@@ -49,6 +53,14 @@ void Viewport::RendererSW::paintFallback(
 	for (const auto &tile : _owner->_tiles) {
 		if (!tile->visible()) {
 			continue;
+		} else if (!tile->geometry().intersects(bounding)) {
+			// The tile is outside the dirty region, so its pixels on
+			// screen are still valid - keep the cached frames around.
+			const auto i = _tileData.find(tile.get());
+			if (i != _tileData.end()) {
+				i->second.stale = false;
+			}
+			continue;
 		}
 		paintTile(p, tile.get(), bounding, bg);
 	}
@@ -64,6 +76,34 @@ void Viewport::RendererSW::paintFallback(
 			++i;
 		}
 	}
+	if (overlay) {
+		paintFrameTimeOverlay(p, crl::now() - started, bounding);
+	}
+}
+
+void Viewport::RendererSW::paintFrameTimeOverlay(
+		Painter &p,
+		crl::time elapsed,
+		const QRect &clip) {
+	// Exponential smoothing, so that a single slow paint doesn't make
+	// the number jump around unreadably.
+	_paintTimeSmoothed = (_paintTimeSmoothed == 0.)
+		? float64(elapsed)
+		: ((_paintTimeSmoothed * 3. + elapsed) / 4.);
+	const auto font = st::normalFont;
+	const auto text = QString::number(_paintTimeSmoothed, 'f', 1) + " ms";
+	const auto rect = QRect(
+		0,
+		0,
+		font->width(text) + font->height,
+		2 * font->height);
+	if (!rect.intersects(clip)) {
+		return;
+	}
+	p.fillRect(rect, QColor(0, 0, 0, 128));
+	p.setFont(font);
+	p.setPen(Qt::white);
+	p.drawText(rect, text, style::al_center);
 }
 
 void Viewport::RendererSW::validateUserpicFrame(
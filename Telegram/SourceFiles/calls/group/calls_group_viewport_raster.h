@@ -52,10 +52,15 @@ private:
 	void validateUserpicFrame(
 		not_null<VideoTile*> tile,
 		TileData &data);
+	void paintFrameTimeOverlay(
+		Painter &p,
+		crl::time elapsed,
+		const QRect &clip);
 
 	const not_null<Viewport*> _owner;
 
 	QImage _shadow;
+	float64 _paintTimeSmoothed = 0.;
 	bool _userpicFrame = false;
 	bool _pausedFrame = false;
 	base::flat_map<not_null<VideoTile*>, TileData> _tileData;
@@ -268,8 +268,8 @@ void Viewport::VideoTile::setup(rpl::producer<bool> pinned) {
 		}
 	}, _lifetime);
 
-	_track.track->renderNextFrame(
-	) | rpl::start_with_next(_update, _lifetime);
+	// Frame arrival repaints are subscribed by the Viewport itself,
+	// so that only this tile's geometry gets invalidated.
 
 	updateTopControlsSize();
 }
@@ -175,30 +175,20 @@ void WriteLocalCache(const QString &id, const LangPackData &data) {
 
 void AppendFoundEmoji(
 		std::vector<Result> &result,
+		base::flat_set<EmojiPtr> &seen,
 		const QString &label,
 		const std::vector<LangPackEmoji> &list) {
-	// It is important that the 'result' won't relocate while inserting.
 	result.reserve(result.size() + list.size());
-	const auto alreadyBegin = begin(result);
-	const auto alreadyEnd = alreadyBegin + result.size();
-
-	auto &&add = ranges::views::all(
-		list
-	) | ranges::views::filter([&](const LangPackEmoji &entry) {
-		const auto i = ranges::find(
-			alreadyBegin,
-			alreadyEnd,
-			entry.emoji,
-			&Result::emoji);
-		return (i == alreadyEnd);
-	}) | ranges::views::transform([&](const LangPackEmoji &entry) {
-		return Result{ entry.emoji, label, entry.text };
-	});
-	result.insert(end(result), add.begin(), add.end());
+	for (const auto &entry : list) {
+		if (seen.emplace(entry.emoji).second) {
+			result.push_back({ entry.emoji, label, entry.text });
+		}
+	}
 }
 
 void AppendLegacySuggestions(
 		std::vector<Result> &result,
+		base::flat_set<EmojiPtr> &seen,
 		const QString &query) {
 	const auto badSuggestionChar = [](QChar ch) {
 		return (ch < 'a' || ch > 'z')
@@ -214,11 +204,7 @@ void AppendLegacySuggestions(
 
 	const auto suggestions = GetSuggestions(QStringToUTF16(query));
 
-	// It is important that the 'result' won't relocate while inserting.
 	result.reserve(result.size() + suggestions.size());
-	const auto alreadyBegin = begin(result);
-	const auto alreadyEnd = alreadyBegin + result.size();
-
 	auto &&add = ranges::views::all(
 		suggestions
 	) | ranges::views::transform([](const Suggestion &suggestion) {
@@ -228,15 +214,8 @@ void AppendLegacySuggestions(
 			QStringFromUTF16(suggestion.replacement())
 		};
 	}) | ranges::views::filter([&](const Result &entry) {
-		const auto i = entry.emoji
-			? ranges::find(
-				alreadyBegin,
-				alreadyEnd,
-				entry.emoji,
-				&Result::emoji)
-			: alreadyEnd;
 		return (entry.emoji != nullptr)
-			&& (i == alreadyEnd);
+			&& seen.emplace(entry.emoji).second;
 	});
 	result.insert(end(result), add.begin(), add.end());
 }
@@ -489,8 +468,9 @@ std::vector<Result> EmojiKeywords::LangPack::query(
 	});
 
 	auto result = std::vector<Result>();
+	auto seen = base::flat_set<EmojiPtr>();
 	for (const auto &[key, list] : chosen) {
-		AppendFoundEmoji(result, key, list);
+		AppendFoundEmoji(result, seen, key, list);
 	}
 	return result;
 }
@@ -613,30 +593,21 @@ std::vector<Result> EmojiKeywords::query(
 		return {};
 	}
 	auto result = std::vector<Result>();
+	auto seen = base::flat_set<EmojiPtr>();
 	for (const auto &[language, item] : _data) {
 		const auto list = item->query(normalized, exact);
 
-		// It is important that the 'result' won't relocate while inserting.
+		// In each item->query() result the list has no duplicates.
+		// So we need to check only for duplicates between queries.
 		result.reserve(result.size() + list.size());
-		const auto alreadyBegin = begin(result);
-		const auto alreadyEnd = alreadyBegin + result.size();
-
-		auto &&add = ranges::views::all(
-			list
-		) | ranges::views::filter([&](Result entry) {
-			// In each item->query() result the list has no duplicates.
-			// So we need to check only for duplicates between queries.
-			const auto i = ranges::find(
-				alreadyBegin,
-				alreadyEnd,
-				entry.emoji,
-				&Result::emoji);
-			return (i == alreadyEnd);
-		});
-		result.insert(end(result), add.begin(), add.end());
+		for (const auto &entry : list) {
+			if (seen.emplace(entry.emoji).second) {
+				result.push_back(entry);
+			}
+		}
 	}
 	if (!exact) {
-		AppendLegacySuggestions(result, query);
+		AppendLegacySuggestions(result, seen, query);
 	}
 	return result;
 }
@@ -305,6 +305,7 @@ void FieldAutocomplete::showFiltered(
 	_channel = peer->asChannel();
 	if (query.isEmpty()) {
 		_type = Type::Mentions;
+		_noResultsFilter = QString();
 		rowsUpdated(
 			MentionRows(),
 			HashtagRows(),
@@ -340,6 +341,23 @@ void FieldAutocomplete::showFiltered(
 	}
 	_addInlineBots = addInlineBots;
 
+	// Every check in updateFiltered() is a prefix match, so a query that
+	// extends a prefix without suggestions can't match anything either -
+	// skip rescanning the candidate lists on each further keystroke.
+	if (!_noResultsFilter.isEmpty()
+		&& (_type == _noResultsType)
+		&& (peer.get() == _noResultsPeer)
+		&& (_addInlineBots == _noResultsAddInlineBots)
+		&& _filter.startsWith(_noResultsFilter, Qt::CaseInsensitive)) {
+		rowsUpdated(
+			MentionRows(),
+			HashtagRows(),
+			BotCommandRows(),
+			StickerRows(),
+			resetScroll);
+		return;
+	}
+
 	updateFiltered(resetScroll);
 }
 
@@ -414,6 +432,7 @@ FieldAutocomplete::StickerRows FieldAutocomplete::getStickerSuggestions() {
 
 void FieldAutocomplete::updateFiltered(bool resetScroll) {
 	int32 now = base::unixtime::now(), recentInlineBots = 0;
+	bool incomplete = false;
 	MentionRows mrows;
 	HashtagRows hrows;
 	BotCommandRows brows;
@@ -474,6 +493,7 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			mrows.reserve(mrows.size() + (_chat->participants.empty() ? _chat->lastAuthors.size() : _chat->participants.size()));
 			if (_chat->noParticipantInfo()) {
 				_chat->session().api().requestFullPeer(_chat);
+				incomplete = true;
 			} else if (!_chat->participants.empty()) {
 				for (const auto &user : _chat->participants) {
 					if (user->isInaccessible()) continue;
@@ -497,6 +517,7 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			if (!_channel->canViewMembers()) {
 				if (!_channel->mgInfo->adminsLoaded) {
 					_channel->session().api().chatParticipants().requestAdmins(_channel);
+					incomplete = true;
 				} else {
 					mrows.reserve(mrows.size() + _channel->mgInfo->admins.size());
 					for (const auto &[userId, rank] : _channel->mgInfo->admins) {
@@ -511,6 +532,7 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			} else if (_channel->lastParticipantsRequestNeeded()) {
 				_channel->session().api().chatParticipants().requestLast(
 					_channel);
+				incomplete = true;
 			} else {
 				mrows.reserve(mrows.size() + _channel->mgInfo->lastParticipants.size());
 				for (const auto user : _channel->mgInfo->lastParticipants) {
@@ -546,6 +568,7 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 		if (_chat) {
 			if (_chat->noParticipantInfo()) {
 				_chat->session().api().requestFullPeer(_chat);
+				incomplete = true;
 			} else if (!_chat->participants.empty()) {
 				const auto &commands = _chat->botCommands();
 				for (const auto &user : _chat->participants) {
@@ -562,6 +585,7 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 		} else if (_user && _user->isBot()) {
 			if (!_user->botInfo->inited) {
 				_user->session().api().requestFullPeer(_user);
+				incomplete = true;
 			}
 			cnt = _user->botInfo->commands.size();
 			bots.emplace(_user, &_user->botInfo->commands);
@@ -570,6 +594,7 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 				if (!_channel->mgInfo->botStatus) {
 					_channel->session().api().chatParticipants().requestBots(
 						_channel);
+					incomplete = true;
 				}
 			} else {
 				const auto &commands = _channel->mgInfo->botCommands();
@@ -663,6 +688,27 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			}
 		}
 	}
+	// Remember dead-end prefixes, but only when the candidate lists were
+	// complete - a pass that just requested participants or bot info may
+	// find matches once the response arrives.
+	if (!_emoji
+		&& !incomplete
+		&& !_filter.isEmpty()
+		&& mrows.empty()
+		&& hrows.empty()
+		&& brows.empty()
+		&& srows.empty()) {
+		_noResultsPeer = _chat
+			? static_cast<PeerData*>(_chat)
+			: _user
+			? static_cast<PeerData*>(_user)
+			: static_cast<PeerData*>(_channel);
+		_noResultsFilter = _filter;
+		_noResultsType = _type;
+		_noResultsAddInlineBots = _addInlineBots;
+	} else {
+		_noResultsFilter = QString();
+	}
 	rowsUpdated(
 		std::move(mrows),
 		std::move(hrows),
@@ -1328,7 +1374,7 @@ void FieldAutocomplete::Inner::mousePressEvent(QMouseEvent *e) {
 				}
 			}
 			if (removed) {
-				_show->session().local().writeRecentHashtagsAndBots();
+				_show->session().local().writeRecentHashtagsAndBotsDelayed();
 			}
 			_parent->updateFiltered();
 
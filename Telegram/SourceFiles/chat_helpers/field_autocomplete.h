@@ -189,6 +189,11 @@ private:
 	QRect _boundings;
 	bool _addInlineBots;
 
+	PeerData *_noResultsPeer = nullptr;
+	QString _noResultsFilter;
+	Type _noResultsType = Type::Mentions;
+	bool _noResultsAddInlineBots = false;
+
 	bool _hiding = false;
 
 	Ui::Animations::Simple _a_opacity;
@@ -655,6 +655,87 @@ AutocompleteQuery ParseMentionHashtagBotCommandQuery(
 	return result;
 }
 
+// Enumerates plain link candidates in [from, till) of the text, calling
+// the callback for each found range. Candidates never cross line breaks,
+// so the bounds may safely be paragraph boundaries.
+template <typename Callback>
+void EnumerateLinkRanges(
+		const QString &text,
+		int from,
+		int till,
+		Callback &&callback) {
+	const QChar *start = text.unicode(), *end = start + text.size();
+	for (auto offset = from, matchOffset = offset; offset < till;) {
+		auto m = qthelp::RegExpDomain().match(text, matchOffset);
+		if (!m.hasMatch()) break;
+
+		auto domainOffset = m.capturedStart();
+		if (domainOffset >= till) {
+			break;
+		}
+
+		auto protocol = m.captured(1).toLower();
+		auto topDomain = m.captured(3).toLower();
+		auto isProtocolValid = protocol.isEmpty() || TextUtilities::IsValidProtocol(protocol);
+		auto isTopDomainValid = !protocol.isEmpty() || TextUtilities::IsValidTopDomain(topDomain);
+
+		if (protocol.isEmpty() && domainOffset > offset + 1 && *(start + domainOffset - 1) == QChar('@')) {
+			auto forMailName = text.mid(offset, domainOffset - offset - 1);
+			auto mMailName = TextUtilities::RegExpMailNameAtEnd().match(forMailName);
+			if (mMailName.hasMatch()) {
+				offset = matchOffset = m.capturedEnd();
+				continue;
+			}
+		}
+		if (!isProtocolValid || !isTopDomainValid) {
+			offset = matchOffset = m.capturedEnd();
+			continue;
+		}
+
+		QStack<const QChar*> parenth;
+		const QChar *domainEnd = start + m.capturedEnd(), *p = domainEnd;
+		for (; p < end; ++p) {
+			QChar ch(*p);
+			if (IsLinkEnd(ch)) {
+				break; // link finished
+			} else if (IsAlmostLinkEnd(ch)) {
+				const QChar *endTest = p + 1;
+				while (endTest < end && IsAlmostLinkEnd(*endTest)) {
+					++endTest;
+				}
+				if (endTest >= end || IsLinkEnd(*endTest)) {
+					break; // link finished at p
+				}
+				p = endTest;
+				ch = *p;
+			}
+			if (ch == '(' || ch == '[' || ch == '{' || ch == '<') {
+				parenth.push(p);
+			} else if (ch == ')' || ch == ']' || ch == '}' || ch == '>') {
+				if (parenth.isEmpty()) break;
+				const QChar *q = parenth.pop(), open(*q);
+				if ((ch == ')' && open != '(') || (ch == ']' && open != '[') || (ch == '}' && open != '{') || (ch == '>' && open != '<')) {
+					p = q;
+					break;
+				}
+			}
+		}
+		if (p > domainEnd) { // check, that domain ended
+			if (domainEnd->unicode() != '/' && domainEnd->unicode() != '?') {
+				matchOffset = domainEnd - start;
+				continue;
+			}
+		}
+		const auto range = MessageLinkRange{
+			int(domainOffset),
+			static_cast<int>(p - start - domainOffset),
+			QString()
+		};
+		callback(range);
+		offset = matchOffset = p - start;
+	}
+}
+
 MessageLinksParser::MessageLinksParser(not_null<Ui::InputField*> field)
 : _field(field)
 , _timer([=] { parse(); }) {
@@ -714,10 +795,21 @@ void MessageLinksParser::parse() {
 	const auto &tags = textWithTags.tags;
 	const auto &markdownTags = _field->getMarkdownTags();
 	if (_disabled || text.isEmpty()) {
+		_parsedText = QString();
+		_parsedPlain = false;
 		_ranges = {};
 		_list = QStringList();
 		return;
 	}
+	if (_parsedPlain
+		&& !_parsedText.isEmpty()
+		&& tags.isEmpty()
+		&& markdownTags.empty()
+		&& parseIncremental(text)) {
+		_parsedText = text;
+		applyRanges(text);
+		return;
+	}
 	const auto tagCanIntersectWithLink = [](const QString &tag) {
 		return (tag == Ui::InputField::kTagBold)
 			|| (tag == Ui::InputField::kTagItalic)
@@ -778,84 +870,79 @@ void MessageLinksParser::parse() {
 				+ markdownTag->adjustedLength < from + length);
 	};
 
-	const auto len = text.size();
-	const QChar *start = text.unicode(), *end = start + text.size();
-	for (auto offset = 0, matchOffset = offset; offset < len;) {
-		auto m = qthelp::RegExpDomain().match(text, matchOffset);
-		if (!m.hasMatch()) break;
-
-		auto domainOffset = m.capturedStart();
-
-		auto protocol = m.captured(1).toLower();
-		auto topDomain = m.captured(3).toLower();
-		auto isProtocolValid = protocol.isEmpty() || TextUtilities::IsValidProtocol(protocol);
-		auto isTopDomainValid = !protocol.isEmpty() || TextUtilities::IsValidTopDomain(topDomain);
-
-		if (protocol.isEmpty() && domainOffset > offset + 1 && *(start + domainOffset - 1) == QChar('@')) {
-			auto forMailName = text.mid(offset, domainOffset - offset - 1);
-			auto mMailName = TextUtilities::RegExpMailNameAtEnd().match(forMailName);
-			if (mMailName.hasMatch()) {
-				offset = matchOffset = m.capturedEnd();
-				continue;
-			}
-		}
-		if (!isProtocolValid || !isTopDomainValid) {
-			offset = matchOffset = m.capturedEnd();
-			continue;
-		}
-
-		QStack<const QChar*> parenth;
-		const QChar *domainEnd = start + m.capturedEnd(), *p = domainEnd;
-		for (; p < end; ++p) {
-			QChar ch(*p);
-			if (IsLinkEnd(ch)) {
-				break; // link finished
-			} else if (IsAlmostLinkEnd(ch)) {
-				const QChar *endTest = p + 1;
-				while (endTest < end && IsAlmostLinkEnd(*endTest)) {
-					++endTest;
-				}
-				if (endTest >= end || IsLinkEnd(*endTest)) {
-					break; // link finished at p
-				}
-				p = endTest;
-				ch = *p;
-			}
-			if (ch == '(' || ch == '[' || ch == '{' || ch == '<') {
-				parenth.push(p);
-			} else if (ch == ')' || ch == ']' || ch == '}' || ch == '>') {
-				if (parenth.isEmpty()) break;
-				const QChar *q = parenth.pop(), open(*q);
-				if ((ch == ')' && open != '(') || (ch == ']' && open != '[') || (ch == '}' && open != '{') || (ch == '>' && open != '<')) {
-					p = q;
-					break;
-				}
-			}
-		}
-		if (p > domainEnd) { // check, that domain ended
-			if (domainEnd->unicode() != '/' && domainEnd->unicode() != '?') {
-				matchOffset = domainEnd - start;
-				continue;
-			}
-		}
-		const auto range = MessageLinkRange{
-			int(domainOffset),
-			static_cast<int>(p - start - domainOffset),
-			QString()
-		};
-		processTagsBefore(domainOffset);
+	EnumerateLinkRanges(text, 0, int(text.size()), [&](
+			const MessageLinkRange &range) {
+		processTagsBefore(range.start);
 		if (!hasTagsIntersection(range.start + range.length)) {
 			if (markdownTagsAllow(range.start, range.length)) {
 				_ranges.push_back(range);
 			}
 		}
-		offset = matchOffset = p - start;
-	}
+	});
 	processTagsBefore(Ui::kQFixedMax);
 
+	_parsedText = text;
+	_parsedPlain = (tags.isEmpty() && markdownTags.empty());
+
 	applyRanges(text);
 }
 
+bool MessageLinksParser::parseIncremental(const QString &text) {
+	// Only plain-text-to-plain-text edits take this path, so all cached
+	// ranges are detected links (no custom tag links) and no tags can
+	// filter the rescanned ones.
+	const auto &was = _parsedText;
+	const auto nowLength = int(text.size());
+	const auto wasLength = int(was.size());
+	const auto minLength = std::min(wasLength, nowLength);
+	auto prefix = 0;
+	while (prefix != minLength && text[prefix] == was[prefix]) {
+		++prefix;
+	}
+	auto suffix = 0;
+	while (suffix != minLength - prefix
+		&& text[nowLength - 1 - suffix] == was[wasLength - 1 - suffix]) {
+		++suffix;
+	}
+	// Expand the edited span to paragraph boundaries, links can't cross
+	// line breaks, so everything outside relayouts to the same ranges.
+	auto dirtyFrom = prefix;
+	while (dirtyFrom > 0 && text[dirtyFrom - 1] != '\n') {
+		--dirtyFrom;
+	}
+	auto dirtyTill = nowLength - suffix;
+	while (dirtyTill != nowLength && text[dirtyTill] != '\n') {
+		++dirtyTill;
+	}
+	if (2 * (dirtyTill - dirtyFrom) > nowLength) {
+		// The edited paragraph covers most of the text anyway.
+		return false;
+	}
+	const auto delta = nowLength - wasLength;
+	const auto wasDirtyTill = dirtyTill - delta;
+	auto ranges = std::vector<MessageLinkRange>();
+	ranges.reserve(_ranges.size());
+	for (const auto &range : _ranges) {
+		if (range.start + range.length <= dirtyFrom) {
+			ranges.push_back(range);
+		}
+	}
+	EnumerateLinkRanges(text, dirtyFrom, dirtyTill, [&](
+			const MessageLinkRange &range) {
+		ranges.push_back(range);
+	});
+	for (const auto &range : _ranges) {
+		if (range.start >= wasDirtyTill) {
+			ranges.push_back({
+				range.start + delta,
+				range.length,
+				range.custom });
+		}
+	}
+	_ranges = std::move(ranges);
+	return true;
+}
+
 void MessageLinksParser::applyRanges(const QString &text) {
 	const auto count = int(_ranges.size());
 	const auto current = _list.current();
@@ -132,11 +132,14 @@ private:
 	bool eventFilter(QObject *object, QEvent *event) override;
 
 	void parse();
+	[[nodiscard]] bool parseIncremental(const QString &text);
 	void applyRanges(const QString &text);
 
 	not_null<Ui::InputField*> _field;
 	rpl::variable<QStringList> _list;
 	std::vector<MessageLinkRange> _ranges;
+	QString _parsedText;
+	bool _parsedPlain = false;
 	int _lastLength = 0;
 	bool _disabled = false;
 	base::Timer _timer;
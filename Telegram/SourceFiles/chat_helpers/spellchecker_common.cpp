@@ -125,6 +125,11 @@ using DictLoaderPtr = std::shared_ptr<base::unique_qptr<DictLoader>>;
 DictLoaderPtr BackgroundLoader;
 rpl::event_stream<int> BackgroundLoaderChanged;
 
+// Dictionaries don't disappear from disk behind our back, so positive
+// existence checks can be cached, saving the UI thread the repeated
+// filesystem stats on locale changes and settings recomputations.
+base::flat_set<int> ExistingDictionaries;
+
 void SetBackgroundLoader(DictLoaderPtr loader) {
 	BackgroundLoader = std::move(loader);
 }
@@ -262,18 +267,25 @@ bool UnpackDictionary(const QString &path, int langId) {
 bool DictionaryExists(int langId) {
 	if (!langId) {
 		return true;
+	} else if (ExistingDictionaries.contains(langId)) {
+		return true;
 	}
 	const auto folder = DictPathByLangId(langId) + '/';
-	return ranges::none_of(kDictExtensions, [&](const auto &ext) {
+	const auto exists = ranges::none_of(kDictExtensions, [&](const auto &ext) {
 		const auto name = Spellchecker::LocaleFromLangId(langId).name();
 		return !QFile(folder + name + '.' + ext).exists();
 	});
+	if (exists) {
+		ExistingDictionaries.emplace(langId);
+	}
+	return exists;
 }
 
 bool RemoveDictionary(int langId) {
 	if (!langId) {
 		return true;
 	}
+	ExistingDictionaries.remove(langId);
 	const auto fileName = Spellchecker::LocaleFromLangId(langId).name();
 	const auto folder = u"%1/%2/"_q.arg(
 		DictionariesPath(),
@@ -16,15 +16,14 @@ EmojiImageLoader::EmojiImageLoader(crl::weak_on_queue<EmojiImageLoader> weak)
 : _weak(std::move(weak)) {
 }
 
-void EmojiImageLoader::init(
-		std::shared_ptr<UniversalImages> images,
-		bool largeEnabled) {
+void EmojiImageLoader::init(std::shared_ptr<UniversalImages> images) {
 	Expects(images != nullptr);
 
+	// The sprites stay undecoded until the first large emoji is actually
+	// painted - prepare() loads them on this same queue, so eagerly
+	// decoding tens of megabytes at startup only costs resident memory
+	// for users who never see a large emoji.
 	_images = std::move(images);
-	if (largeEnabled) {
-		_images->ensureLoaded();
-	}
 }
 
 QImage EmojiImageLoader::prepare(EmojiPtr emoji) const {
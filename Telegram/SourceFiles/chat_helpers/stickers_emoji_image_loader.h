@@ -17,9 +17,7 @@ public:
 
 	explicit EmojiImageLoader(crl::weak_on_queue<EmojiImageLoader> weak);
 
-	void init(
-		std::shared_ptr<UniversalImages> images,
-		bool largeEnabled);
+	void init(std::shared_ptr<UniversalImages> images);
 
 	[[nodiscard]] QImage prepare(EmojiPtr emoji) const;
 	void switchTo(std::shared_ptr<UniversalImages> images);
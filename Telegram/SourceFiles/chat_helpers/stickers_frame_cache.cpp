@@ -0,0 +1,92 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "chat_helpers/stickers_frame_cache.h"
+
+namespace ChatHelpers {
+namespace {
+
+[[nodiscard]] int64 FrameBytes(const QImage &frame) {
+	return int64(frame.height()) * frame.bytesPerLine();
+}
+
+} // namespace
+
+QImage StickersFrameCache::frame(DocumentId document, QSize size) {
+	const auto key = Key{ document, size.width(), size.height() };
+	const auto i = _entries.find(key);
+	if (i == end(_entries)) {
+		return QImage();
+	}
+	_lru.splice(begin(_lru), _lru, i->second.lruPosition);
+	return i->second.frame;
+}
+
+bool StickersFrameCache::has(DocumentId document, QSize size) const {
+	return _entries.contains(
+		Key{ document, size.width(), size.height() });
+}
+
+void StickersFrameCache::save(
+		DocumentId document,
+		QSize size,
+		const QImage &frame) {
+	if (frame.isNull()) {
+		return;
+	}
+	const auto key = Key{ document, size.width(), size.height() };
+	if (_entries.contains(key)) {
+		return;
+	}
+	_lru.push_front(key);
+	const auto bytes = FrameBytes(frame);
+	_entries.emplace(key, Entry{ frame, begin(_lru), bytes });
+	_usedBytes += bytes;
+	evictIfOverBudget();
+}
+
+void StickersFrameCache::remove(DocumentId document) {
+	for (auto i = begin(_entries); i != end(_entries);) {
+		if (i->first.document == document) {
+			_usedBytes -= i->second.bytes;
+			_lru.erase(i->second.lruPosition);
+			i = _entries.erase(i);
+		} else {
+			++i;
+		}
+	}
+}
+
+void StickersFrameCache::clear() {
+	_entries.clear();
+	_lru.clear();
+	_usedBytes = 0;
+}
+
+void StickersFrameCache::setBudget(int64 bytes) {
+	Expects(bytes > 0);
+
+	_budget = bytes;
+	evictIfOverBudget();
+}
+
+void StickersFrameCache::evictIfOverBudget() {
+	while (_usedBytes > _budget && !_lru.empty()) {
+		const auto i = _entries.find(_lru.back());
+		Assert(i != end(_entries));
+		_usedBytes -= i->second.bytes;
+		_entries.erase(i);
+		_lru.pop_back();
+	}
+}
+
+StickersFrameCache &SharedStickersFrameCache() {
+	static auto result = StickersFrameCache();
+	return result;
+}
+
+} // namespace ChatHelpers
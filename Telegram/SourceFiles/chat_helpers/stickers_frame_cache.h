@@ -0,0 +1,61 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace ChatHelpers {
+
+// Shared budgeted cache of first-frame sticker rasters, keyed by document
+// and cell size. The picker widgets used to keep one premultiplied QImage
+// per sticker per widget; with hundreds of installed packs that added up
+// to hundreds of megabytes. Main thread only.
+class StickersFrameCache final {
+public:
+	static constexpr auto kDefaultBudget = int64(64 * 1024 * 1024);
+
+	// Returns a null image when the frame is not cached, marks the entry
+	// as recently used otherwise.
+	[[nodiscard]] QImage frame(DocumentId document, QSize size);
+	[[nodiscard]] bool has(DocumentId document, QSize size) const;
+
+	// Keeps an already cached frame, mirroring the old save-once logic.
+	void save(DocumentId document, QSize size, const QImage &frame);
+
+	void remove(DocumentId document);
+	void clear();
+
+	void setBudget(int64 bytes);
+	[[nodiscard]] int64 usedBytes() const {
+		return _usedBytes;
+	}
+
+private:
+	struct Key {
+		DocumentId document = 0;
+		int width = 0;
+		int height = 0;
+
+		friend inline auto operator<=>(const Key&, const Key&) = default;
+	};
+	struct Entry {
+		QImage frame;
+		std::list<Key>::iterator lruPosition;
+		int64 bytes = 0;
+	};
+
+	void evictIfOverBudget();
+
+	base::flat_map<Key, Entry> _entries;
+	std::list<Key> _lru; // Most recently used in front.
+	int64 _usedBytes = 0;
+	int64 _budget = kDefaultBudget;
+
+};
+
+[[nodiscard]] StickersFrameCache &SharedStickersFrameCache();
+
+} // namespace ChatHelpers
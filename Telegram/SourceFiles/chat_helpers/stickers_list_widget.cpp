@@ -18,6 +18,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_changes.h"
 #include "data/data_peer_values.h"
 #include "menu/menu_send.h" // SendMenu::FillSendMenu
+#include "chat_helpers/stickers_frame_cache.h"
 #include "chat_helpers/stickers_lottie.h"
 #include "chat_helpers/stickers_list_footer.h"
 #include "ui/controls/tabbed_search.h"
@@ -81,8 +82,6 @@ struct StickersListWidget::Sticker {
 	std::shared_ptr<Data::DocumentMedia> documentMedia;
 	Lottie::Animation *lottie = nullptr;
 	Media::Clip::ReaderPointer webm;
-	QImage savedFrame;
-	QSize savedFrameFor;
 	QImage premiumLock;
 
 	void ensureMediaCreated();
@@ -792,8 +791,6 @@ void StickersListWidget::takeHeavyData(Set &to, Set &from) {
 
 void StickersListWidget::takeHeavyData(Sticker &to, Sticker &from) {
 	to.documentMedia = std::move(from.documentMedia);
-	to.savedFrame = std::move(from.savedFrame);
-	to.savedFrameFor = from.savedFrameFor;
 	to.lottie = base::take(from.lottie);
 	to.webm = base::take(from.webm);
 }
@@ -1078,8 +1075,7 @@ void StickersListWidget::clearHeavyIn(Set &set, bool clearSavedFrames) {
 	const auto lifetime = base::take(set.lottieLifetime);
 	for (auto &sticker : set.stickers) {
 		if (clearSavedFrames) {
-			sticker.savedFrame = QImage();
-			sticker.savedFrameFor = QSize();
+			SharedStickersFrameCache().remove(sticker.document->id);
 		}
 		sticker.webm = nullptr;
 		sticker.lottie = nullptr;
@@ -1364,11 +1360,19 @@ void StickersListWidget::paintSticker(
 	const auto premium = document->isPremiumSticker();
 	const auto isLottie = document->sticker()->isLottie();
 	const auto isWebm = document->sticker()->isWebm();
+	// While the panel is paused a cached first frame is all that gets
+	// painted, so don't spin up a player just to render it again.
+	const auto cachedWhilePaused = paused
+		&& SharedStickersFrameCache().has(document->id, _singleSize);
 	if (isLottie
 		&& !sticker.lottie
-		&& media->loaded()) {
+		&& media->loaded()
+		&& !cachedWhilePaused) {
 		setupLottie(set, section, index);
-	} else if (isWebm && !sticker.webm && media->loaded()) {
+	} else if (isWebm
+		&& !sticker.webm
+		&& media->loaded()
+		&& !cachedWhilePaused) {
 		setupWebm(set, section, index);
 	}
 
@@ -1389,6 +1393,7 @@ void StickersListWidget::paintSticker(
 		(_singleSize.height() - size.height()) / 2);
 
 	auto lottieFrame = QImage();
+	auto &frameCache = SharedStickersFrameCache();
 	if (sticker.lottie && sticker.lottie->ready()) {
 		auto request = Lottie::FrameRequest();
 		request.box = boundingBoxSize() * cIntRetinaFactor();
@@ -1396,39 +1401,38 @@ void StickersListWidget::paintSticker(
 		p.drawImage(
 			QRect(ppos, lottieFrame.size() / cIntRetinaFactor()),
 			lottieFrame);
-		if (sticker.savedFrame.isNull()) {
-			sticker.savedFrame = lottieFrame;
-			sticker.savedFrame.setDevicePixelRatio(cRetinaFactor());
-			sticker.savedFrameFor = _singleSize;
+		if (!frameCache.has(document->id, _singleSize)) {
+			auto saved = lottieFrame;
+			saved.setDevicePixelRatio(cRetinaFactor());
+			frameCache.save(document->id, _singleSize, saved);
 		}
 		set.lottiePlayer->unpause(sticker.lottie);
 	} else if (sticker.webm && sticker.webm->started()) {
 		const auto frame = sticker.webm->current(
 			{ .frame = size, .keepAlpha = true },
 			paused ? 0 : now);
-		if (sticker.savedFrame.isNull()) {
-			sticker.savedFrame = frame;
-			sticker.savedFrame.setDevicePixelRatio(cRetinaFactor());
-			sticker.savedFrameFor = _singleSize;
+		if (!frameCache.has(document->id, _singleSize)) {
+			auto saved = frame;
+			saved.setDevicePixelRatio(cRetinaFactor());
+			frameCache.save(document->id, _singleSize, saved);
 		}
 		p.drawImage(ppos, frame);
 	} else {
 		const auto image = media->getStickerSmall();
-		const auto useSavedFrame = !sticker.savedFrame.isNull()
-			&& (sticker.savedFrameFor == _singleSize);
-		if (useSavedFrame) {
-			p.drawImage(ppos, sticker.savedFrame);
+		const auto saved = frameCache.frame(document->id, _singleSize);
+		if (!saved.isNull()) {
+			p.drawImage(ppos, saved);
 			if (premium) {
-				lottieFrame = sticker.savedFrame;
+				lottieFrame = saved;
 			}
 		} else if (image) {
 			const auto pixmap = image->pixSingle(size, { .outer = size });
 			p.drawPixmapLeft(ppos, width(), pixmap);
-			if (sticker.savedFrame.isNull()) {
-				sticker.savedFrame = pixmap.toImage().convertToFormat(
-					QImage::Format_ARGB32_Premultiplied);
-				sticker.savedFrameFor = _singleSize;
-			}
+			frameCache.save(
+				document->id,
+				_singleSize,
+				pixmap.toImage().convertToFormat(
+					QImage::Format_ARGB32_Premultiplied));
 			if (premium) {
 				lottieFrame = pixmap.toImage().convertToFormat(
 					QImage::Format_ARGB32_Premultiplied);
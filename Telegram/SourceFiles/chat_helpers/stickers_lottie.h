@@ -70,6 +70,11 @@ enum class StickerLottieSize : uint8 {
 	uint8 replacementsTag,
 	StickerLottieSize sizeTag);
 
+// One shared renderer thread for the sticker players in chat histories,
+// so that they don't compete for the library-wide default renderer with
+// reaction effects and other small animations.
+[[nodiscard]] std::shared_ptr<Lottie::FrameRenderer> ChatLottieRenderer();
+
 [[nodiscard]] std::unique_ptr<Lottie::SinglePlayer> LottiePlayerFromDocument(
 	not_null<Data::DocumentMedia*> media,
 	StickerLottieSize sizeTag,
@@ -17,6 +17,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_channel.h"
 #include "data/data_download_manager.h"
 #include "base/battery_saving.h"
+#include "base/call_delayed.h"
 #include "base/event_filter.h"
 #include "base/concurrent_timer.h"
 #include "base/qt_signal_producer.h"
@@ -85,6 +86,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/effects/spoiler_mess.h"
 #include "ui/cached_round_corners.h"
 #include "ui/power_saving.h"
+#include "storage/details/storage_startup_prefetch.h"
 #include "storage/serialize_common.h"
 #include "storage/storage_domain.h"
 #include "storage/storage_databases.h"
@@ -115,6 +117,7 @@ constexpr auto kQuitPreventTimeoutMs = crl::time(1500);
 constexpr auto kAutoLockTimeoutLateMs = crl::time(3000);
 constexpr auto kClearEmojiImageSourceTimeout = 10 * crl::time(1000);
 constexpr auto kFileOpenTimeoutMs = crl::time(1000);
+constexpr auto kFinishPrefetchRecordingTimeout = 10 * crl::time(1000);
 
 LaunchState GlobalLaunchState/* = LaunchState::Running*/;
 
@@ -299,7 +302,13 @@ void Application::run() {
 		_batterySaving->value(),
 		settings().ignoreBatterySavingValue()
 	) | rpl::start_with_next([=](bool saving, bool ignore) {
-		PowerSaving::SetForceAll(saving && !ignore);
+		const auto force = saving && !ignore;
+		if (PowerSaving::ForceAll() != force) {
+			DEBUG_LOG(("Power Saving: Battery saving %1 (ignore: %2)."
+				).arg(Logs::b(saving)
+				).arg(Logs::b(ignore)));
+		}
+		PowerSaving::SetForceAll(force);
 	}, _lifetime);
 
 	style::ShortAnimationPlaying(
@@ -407,6 +416,12 @@ void Application::run() {
 	}
 
 	processCreatedWindow(_lastActivePrimaryWindow);
+
+	// By now the startup reads that matter have happened, the account
+	// maps included - snapshot them as the next launch's prefetch set.
+	base::call_delayed(kFinishPrefetchRecordingTimeout, this, [] {
+		Storage::details::FinishPrefetchRecording();
+	});
 }
 
 void Application::showAccount(not_null<Main::Account*> account) {
@@ -806,10 +821,9 @@ void Application::startLocalStorage() {
 
 void Application::startEmojiImageLoader() {
 	_emojiImageLoader.with([
-		source = prepareEmojiSourceImages(),
-		large = settings().largeEmoji()
+		source = prepareEmojiSourceImages()
 	](Stickers::EmojiImageLoader &loader) mutable {
-		loader.init(std::move(source), large);
+		loader.init(std::move(source));
 	});
 
 	settings().largeEmojiChanges(
@@ -909,6 +923,15 @@ void Application::checkLocalTime() {
 		base::Timer::Adjust();
 		base::ConcurrentTimerEnvironment::Adjust();
 		base::unixtime::http_invalidate();
+
+		// The monotonic clock jumped, so we most likely went through
+		// a suspend cycle and the sockets are silently dead - re-dial
+		// right away instead of waiting for receive timeouts to expire.
+		for (const auto &[index, account] : _domain->accounts()) {
+			if (account->sessionExists()) {
+				account->mtp().restart();
+			}
+		}
 	}
 	if (const auto session = maybePrimarySession()) {
 		session->updates().checkLastUpdate(adjusted);
@@ -292,6 +292,9 @@ void Sandbox::socketConnected() {
 
 	DEBUG_LOG(("Sandbox Info: writing commands %1").arg(commands));
 	_localSocket.write(commands.toLatin1());
+	// Qt keeps the bytes in its buffer until the event loop spins, push
+	// them out right away - the primary instance reacts one turn sooner.
+	_localSocket.flush();
 }
 
 void Sandbox::socketWritten(qint64/* bytes*/) {
@@ -446,6 +449,7 @@ void Sandbox::readClients() {
 					const auto windowId = execExternal(cmds.mid(from + 4, to - from - 4));
 					const auto response = u"RES:%1_%2;"_q.arg(processId).arg(windowId).toLatin1();
 					i->first->write(response.data(), response.size());
+					i->first->flush();
 				} else if (cmd.startsWith(u"SEND:"_q)) {
 					if (cSendPaths().isEmpty()) {
 						toSend.append(_escapeFrom7bit(cmds.mid(from + 5, to - from - 5)));
@@ -461,6 +465,7 @@ void Sandbox::readClients() {
 						: 0;
 					const auto response = u"RES:%1_%2;"_q.arg(processId).arg(windowId).toLatin1();
 					i->first->write(response.data(), response.size());
+					i->first->flush();
 				} else {
 					LOG(("Sandbox Error: unknown command %1 passed in local socket").arg(cmd.toString()));
 				}
@@ -0,0 +1,131 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/tracepoints.h"
+
+#include "logs.h"
+#include "settings.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QThread>
+
+namespace Trace {
+namespace {
+
+constexpr auto kRingSize = 16384;
+
+struct Event {
+	const char *name = nullptr;
+	crl::profile_time start = 0;
+	crl::profile_time finish = 0;
+};
+
+struct Ring {
+	std::array<Event, kRingSize> events;
+	std::atomic<int> count = 0;
+	quint64 threadId = 0;
+};
+
+QMutex RingsMutex;
+std::vector<std::unique_ptr<Ring>> Rings;
+
+thread_local Ring *MyRing = nullptr;
+
+[[nodiscard]] not_null<Ring*> RingForThisThread() {
+	if (!MyRing) {
+		auto ring = std::make_unique<Ring>();
+		ring->threadId = quint64(
+			reinterpret_cast<quintptr>(QThread::currentThreadId()));
+		MyRing = ring.get();
+
+		QMutexLocker lock(&RingsMutex);
+		Rings.push_back(std::move(ring));
+	}
+	return MyRing;
+}
+
+} // namespace
+
+namespace details {
+
+std::atomic<bool> TracingEnabled/* = false*/;
+
+void Record(
+		const char *name,
+		crl::profile_time start,
+		crl::profile_time finish) {
+	const auto ring = RingForThisThread();
+	const auto index = ring->count.load(std::memory_order_relaxed);
+	auto &event = ring->events[index % kRingSize];
+	event.name = name;
+	event.start = start;
+	event.finish = finish;
+	ring->count.store(index + 1, std::memory_order_release);
+}
+
+} // namespace details
+
+void Toggle() {
+	const auto now = !details::TracingEnabled.load();
+	details::TracingEnabled.store(now);
+	LOG(("Tracing: %1").arg(now ? "Enabled." : "Disabled."));
+}
+
+bool Enabled() {
+	return details::TracingEnabled.load();
+}
+
+QString SaveChromeTrace() {
+	auto events = QByteArray();
+
+	QMutexLocker lock(&RingsMutex);
+	for (const auto &ring : Rings) {
+		const auto count = ring->count.load(std::memory_order_acquire);
+		const auto from = std::max(count - kRingSize, 0);
+		for (auto i = from; i != count; ++i) {
+			// Writers don't synchronize with the export, an event being
+			// overwritten right now may come out garbled - acceptable
+			// for a debugging aid, the other ones are still valid.
+			const auto &event = ring->events[i % kRingSize];
+			if (!event.name || event.finish < event.start) {
+				continue;
+			}
+			if (!events.isEmpty()) {
+				events.append(",\n");
+			}
+			events.append("{\"name\":\"");
+			events.append(event.name);
+			events.append("\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+			events.append(QByteArray::number(ring->threadId));
+			events.append(",\"ts\":");
+			events.append(QByteArray::number(qint64(event.start)));
+			events.append(",\"dur\":");
+			events.append(
+				QByteArray::number(qint64(event.finish - event.start)));
+			events.append("}");
+		}
+	}
+	lock.unlock();
+
+	if (events.isEmpty()) {
+		return QString();
+	}
+	const auto path = cWorkingDir()
+		+ u"trace_%1.json"_q.arg(
+			QDateTime::currentDateTime().toString(u"yyyyMMdd_hhmmss"_q));
+	auto file = QFile(path);
+	if (!file.open(QIODevice::WriteOnly)) {
+		LOG(("Tracing Error: Could not open '%1' for writing.").arg(path));
+		return QString();
+	}
+	file.write("{\"traceEvents\":[\n");
+	file.write(events);
+	file.write("\n]}\n");
+	return path;
+}
+
+} // namespace Trace
@@ -0,0 +1,65 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include <crl/crl_time.h>
+
+namespace Trace {
+
+// Lightweight scoped tracepoints for diagnosing UI freezes without a
+// debugger. Events go to fixed-size per-thread ring buffers, recording
+// is a couple of reads while tracing is disabled. The collected events
+// can be saved in the Chrome trace format (chrome://tracing, Perfetto)
+// through the "savetrace" settings code, tracing itself is toggled by
+// the "tracemode" settings code.
+
+void Toggle();
+[[nodiscard]] bool Enabled();
+
+// Returns the path of the written .json or an empty string.
+[[nodiscard]] QString SaveChromeTrace();
+
+namespace details {
+
+extern std::atomic<bool> TracingEnabled;
+
+void Record(
+	const char *name,
+	crl::profile_time start,
+	crl::profile_time finish);
+
+} // namespace details
+
+class Scope final {
+public:
+	explicit Scope(const char *name)
+	: _name(details::TracingEnabled.load(std::memory_order_relaxed)
+		? name
+		: nullptr)
+	, _started(_name ? crl::profile() : 0) {
+	}
+	Scope(const Scope &other) = delete;
+	Scope &operator=(const Scope &other) = delete;
+	~Scope() {
+		if (_name) {
+			details::Record(_name, _started, crl::profile());
+		}
+	}
+
+private:
+	const char *_name = nullptr;
+	crl::profile_time _started = 0;
+
+};
+
+} // namespace Trace
+
+#define TRACE_SCOPE_CONCAT2(a, b) a##b
+#define TRACE_SCOPE_CONCAT(a, b) TRACE_SCOPE_CONCAT2(a, b)
+#define TRACE_SCOPE(name) \
+	const auto TRACE_SCOPE_CONCAT(traceScope, __LINE__) = Trace::Scope(name)
@@ -7,6 +7,9 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #pragma once
 
+// The ids are shared between all copies of a slice, so passing slices
+// around by value (rpl pipelines copy them a lot) doesn't copy the
+// container itself, only the ownership of it.
 template <typename IdsContainer>
 class AbstractSparseIds {
 public:
@@ -14,11 +17,11 @@ public:
 
 	AbstractSparseIds() = default;
 	AbstractSparseIds(
-		const IdsContainer &ids,
+		IdsContainer ids,
 		std::optional<int> fullCount,
 		std::optional<int> skippedBefore,
 		std::optional<int> skippedAfter)
-	: _ids(ids)
+	: _ids(std::make_shared<const IdsContainer>(std::move(ids)))
 	, _fullCount(fullCount)
 	, _skippedBefore(skippedBefore)
 	, _skippedAfter(skippedAfter) {
@@ -34,19 +37,20 @@ public:
 		return _skippedAfter;
 	}
 	[[nodiscard]] std::optional<int> indexOf(Id id) const {
-		const auto it = ranges::find(_ids, id);
-		if (it != _ids.end()) {
-			return (it - _ids.begin());
+		const auto &list = ids();
+		const auto it = ranges::find(list, id);
+		if (it != list.end()) {
+			return (it - list.begin());
 		}
 		return std::nullopt;
 	}
 	[[nodiscard]] int size() const {
-		return _ids.size();
+		return ids().size();
 	}
 	[[nodiscard]] Id operator[](int index) const {
 		Expects(index >= 0 && index < size());
 
-		return *(_ids.begin() + index);
+		return *(ids().begin() + index);
 	}
 	[[nodiscard]] std::optional<int> distance(Id a, Id b) const {
 		if (const auto i = indexOf(a)) {
@@ -58,24 +62,38 @@ public:
 	}
 	[[nodiscard]] std::optional<Id> nearest(Id id) const {
 		static_assert(std::is_same_v<IdsContainer, base::flat_set<Id>>);
-		if (const auto it = ranges::lower_bound(_ids, id); it != _ids.end()) {
+		const auto &list = ids();
+		if (const auto it = ranges::lower_bound(list, id)
+			; it != list.end()) {
 			return *it;
-		} else if (_ids.empty()) {
+		} else if (list.empty()) {
 			return std::nullopt;
 		}
-		return _ids.back();
+		return list.back();
 	}
 	void reverse() {
-		ranges::reverse(_ids);
+		auto copy = ids();
+		ranges::reverse(copy);
+		_ids = std::make_shared<const IdsContainer>(std::move(copy));
 		std::swap(_skippedBefore, _skippedAfter);
 	}
 
 	friend inline bool operator==(
-		const AbstractSparseIds&,
-		const AbstractSparseIds&) = default;
+			const AbstractSparseIds &a,
+			const AbstractSparseIds &b) {
+		return (a._ids == b._ids || a.ids() == b.ids())
+			&& (a._fullCount == b._fullCount)
+			&& (a._skippedBefore == b._skippedBefore)
+			&& (a._skippedAfter == b._skippedAfter);
+	}
 
 private:
-	IdsContainer _ids;
+	[[nodiscard]] const IdsContainer &ids() const {
+		static const auto kEmpty = IdsContainer();
+		return _ids ? *_ids : kEmpty;
+	}
+
+	std::shared_ptr<const IdsContainer> _ids;
 	std::optional<int> _fullCount;
 	std::optional<int> _skippedBefore;
 	std::optional<int> _skippedAfter;
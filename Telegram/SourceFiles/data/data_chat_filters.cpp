@@ -558,11 +558,10 @@ const base::flat_set<not_null<History*>> &ChatFilter::never() const {
 	return _never;
 }
 
-bool ChatFilter::contains(not_null<History*> history) const {
-	if (_never.contains(history)) {
-		return false;
-	}
-	const auto flag = [&] {
+ChatFilter::HistoryState ChatFilter::StateFor(
+		not_null<History*> history,
+		bool needBadges) {
+	const auto type = [&] {
 		const auto peer = history->peer;
 		if (const auto user = peer->asUser()) {
 			return user->isBot()
@@ -579,9 +578,31 @@ bool ChatFilter::contains(not_null<History*> history) const {
 				return Flag::Groups;
 			}
 		} else {
-			Unexpected("Peer type in ChatFilter::contains.");
+			Unexpected("Peer type in ChatFilter::StateFor.");
 		}
 	}();
+	const auto badges = needBadges
+		? history->chatListBadgesState()
+		: Dialogs::BadgesState();
+	return {
+		.type = type,
+		.unread = badges.unread,
+		.mention = badges.mention,
+	};
+}
+
+bool ChatFilter::contains(not_null<History*> history) const {
+	return contains(history, StateFor(
+		history,
+		(_flags & (Flag::NoMuted | Flag::NoRead)) != 0));
+}
+
+bool ChatFilter::contains(
+		not_null<History*> history,
+		const HistoryState &state) const {
+	if (_never.contains(history)) {
+		return false;
+	}
 	const auto filterAdmin = [&] {
 		if (!(_flags & Flag::Owned)
 			&& !(_flags & Flag::NotOwned)
@@ -645,11 +666,8 @@ bool ChatFilter::contains(not_null<History*> history) const {
 
 		return true;
 	};
-	const auto state = (_flags & (Flag::NoMuted | Flag::NoRead))
-		? history->chatListBadgesState()
-		: Dialogs::BadgesState();
 	return false
-		|| ((_flags & flag)
+		|| ((_flags & state.type)
 			&& filterAdmin()
 			&& (!(_flags & Flag::Recent)
 				|| history->owner().session().account().isRecent(history->peer->id))
@@ -1036,9 +1054,12 @@ bool ChatFilters::applyChange(ChatFilter &filter, ChatFilter &&updated) {
 	}
 	if (rulesChanged) {
 		const auto filterList = _owner->chatsFilters().chatsList(id);
+		const auto needBadges = ((filter.flags() | updated.flags())
+			& (Flag::NoMuted | Flag::NoRead)) != 0;
 		const auto feedHistory = [&](not_null<History*> history) {
-			const auto now = updated.contains(history);
-			const auto was = filter.contains(history);
+			const auto state = ChatFilter::StateFor(history, needBadges);
+			const auto now = updated.contains(history, state);
+			const auto was = filter.contains(history, state);
 			if (now != was) {
 				if (now) {
 					history->addToChatList(id, filterList);
@@ -1289,6 +1310,15 @@ void ChatFilters::refreshHistory(not_null<History*> history) {
 	}
 }
 
+ChatFilter::HistoryState ChatFilters::historyState(
+		not_null<History*> history) const {
+	const auto needBadges = ranges::any_of(_list, [](const ChatFilter &f) {
+		return (f.flags() & (ChatFilter::Flag::NoMuted
+			| ChatFilter::Flag::NoRead)) != 0;
+	});
+	return ChatFilter::StateFor(history, needBadges);
+}
+
 void ChatFilters::requestSuggested() {
 	if (_suggestedRequestId) {
 		return;
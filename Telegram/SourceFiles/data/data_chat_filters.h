@@ -98,7 +98,22 @@ public:
 	[[nodiscard]] const std::vector<not_null<History*>> &pinned() const;
 	[[nodiscard]] const base::flat_set<not_null<History*>> &never() const;
 
+	// The parts of contains() that depend only on the history, so that
+	// testing one history against several filters computes them once.
+	// The badge fields must be filled if any filter has NoMuted / NoRead.
+	struct HistoryState {
+		Flags type;
+		bool unread = false;
+		bool mention = false;
+	};
+	[[nodiscard]] static HistoryState StateFor(
+		not_null<History*> history,
+		bool needBadges);
+
 	[[nodiscard]] bool contains(not_null<History*> history) const;
+	[[nodiscard]] bool contains(
+		not_null<History*> history,
+		const HistoryState &state) const;
 
 	[[nodiscard]] bool isLocal() const;
 
@@ -173,6 +188,8 @@ public:
 	bool loadNextExceptions(bool chatsListLoaded);
 
 	void refreshHistory(not_null<History*> history);
+	[[nodiscard]] ChatFilter::HistoryState historyState(
+		not_null<History*> history) const;
 
 	[[nodiscard]] not_null<Dialogs::MainList*> chatsList(FilterId filterId);
 	void clear();
@@ -15,6 +15,23 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "main/main_session.h"
 
 namespace Data {
+namespace {
+
+std::atomic<int64> ResidentImagesCount;
+std::atomic<int64> ResidentImagesBytes;
+
+void AccountImageBytes(int64 delta) {
+	ResidentImagesBytes.fetch_add(delta, std::memory_order_relaxed);
+}
+
+} // namespace
+
+CloudImageResidency CloudImageResidencySnapshot() {
+	return {
+		.images = ResidentImagesCount.load(std::memory_order_relaxed),
+		.bytes = ResidentImagesBytes.load(std::memory_order_relaxed),
+	};
+}
 
 CloudFile::~CloudFile() {
 	// Destroy loader with still alive CloudFile with already zero '.loader'.
@@ -124,7 +141,12 @@ std::shared_ptr<QImage> CloudImage::createView() {
 	if (auto active = activeView()) {
 		return active;
 	}
-	auto view = std::make_shared<QImage>();
+	ResidentImagesCount.fetch_add(1, std::memory_order_relaxed);
+	auto view = std::shared_ptr<QImage>(new QImage(), [](QImage *image) {
+		ResidentImagesCount.fetch_add(-1, std::memory_order_relaxed);
+		AccountImageBytes(-image->sizeInBytes());
+		delete image;
+	});
 	_view = view;
 	return view;
 }
@@ -144,9 +166,11 @@ void CloudImage::setToActive(
 		not_null<Main::Session*> session,
 		QImage image) {
 	if (const auto view = activeView()) {
+		AccountImageBytes(-view->sizeInBytes());
 		*view = image.isNull()
 			? Image::Empty()->original()
 			: std::move(image);
+		AccountImageBytes(view->sizeInBytes());
 		session->notifyDownloaderTaskFinished();
 	}
 }
@@ -27,6 +27,16 @@ namespace Data {
 
 struct FileOrigin;
 
+// Snapshot of the decoded cloud image memory currently resident, for
+// memory instrumentation. Views are pinned by their owners (history
+// elements, overview layouts, userpic caches) and the bytes go away
+// when the last view of an image is destroyed.
+struct CloudImageResidency {
+	int64 images = 0;
+	int64 bytes = 0;
+};
+[[nodiscard]] CloudImageResidency CloudImageResidencySnapshot();
+
 struct CloudFile final {
 	enum class Flag : uchar {
 		Cancelled = 0x01,
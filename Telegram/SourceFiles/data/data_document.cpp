@@ -1340,6 +1340,10 @@ bool DocumentData::hasRemoteLocation() const {
 	return (_dc != 0 && _access != 0);
 }
 
+int32 DocumentData::remoteDcId() const {
+	return _dc;
+}
+
 bool DocumentData::useStreamingLoader() const {
 	if (size <= 0) {
 		return false;
@@ -1491,6 +1495,10 @@ Storage::Cache::Key DocumentData::cacheKey() const {
 	}
 }
 
+Storage::Cache::Key DocumentData::waveformCacheKey() const {
+	return Data::DocumentWaveformCacheKey(_dc, id);
+}
+
 uint8 DocumentData::cacheTag() const {
 	if (type == StickerDocument) {
 		return Data::kStickerCacheTag;
@@ -556,6 +556,7 @@ void ForumTopic::setChatListMessage(HistoryItem *item) {
 }
 
 void ForumTopic::chatListPreloadData() {
+	validateIcon();
 	if (_icon) {
 		[[maybe_unused]] const auto preload = _icon->ready();
 	}
@@ -568,6 +569,7 @@ void ForumTopic::paintUserpic(
 		const Dialogs::Ui::PaintContext &context) const {
 	const auto &st = context.st;
 	auto position = QPoint(st->padding.left(), st->padding.top());
+	validateIcon();
 	if (_icon) {
 		if (context.narrow) {
 			const auto ratio = style::DevicePixelRatio();
@@ -613,6 +615,21 @@ void ForumTopic::clearUserpicLoops() {
 	}
 }
 
+void ForumTopic::validateIcon() const {
+	if (_icon || !_iconId) {
+		return;
+	}
+	// Created on first paint - communities have thousands of topics and
+	// most of their icons never make it to the screen.
+	const auto that = const_cast<ForumTopic*>(this);
+	_icon = std::make_unique<Ui::Text::LimitedLoopsEmoji>(
+		owner().customEmojiManager().create(
+			_iconId,
+			[=] { that->updateChatListEntry(); },
+			Data::CustomEmojiManager::SizeTag::Normal),
+		kUserpicLoopsCount);
+}
+
 void ForumTopic::validateDefaultIcon() const {
 	if (!_defaultIcon.isNull()) {
 		return;
@@ -724,14 +741,7 @@ void ForumTopic::applyIconId(DocumentId iconId) {
 	}
 	_iconId = iconId;
 	invalidateTitleWithIcon();
-	_icon = iconId
-		? std::make_unique<Ui::Text::LimitedLoopsEmoji>(
-			owner().customEmojiManager().create(
-				_iconId,
-				[=] { updateChatListEntry(); },
-				Data::CustomEmojiManager::SizeTag::Normal),
-			kUserpicLoopsCount)
-		: nullptr;
+	_icon = nullptr;
 	if (iconId) {
 		_defaultIcon = QImage();
 	}
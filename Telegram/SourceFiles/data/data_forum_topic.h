@@ -176,6 +176,7 @@ private:
 	using Flags = base::flags<Flag>;
 
 	void indexTitleParts();
+	void validateIcon() const;
 	void validateDefaultIcon() const;
 	void validateGeneralIcon(const Dialogs::Ui::PaintContext &context) const;
 	void applyTopicTopMessage(MsgId topMessageId);
@@ -213,7 +214,7 @@ private:
 	int32 _colorId = 0;
 	mutable Flags _flags;
 
-	std::unique_ptr<Ui::Text::CustomEmoji> _icon;
+	mutable std::unique_ptr<Ui::Text::CustomEmoji> _icon; // on-demand
 	mutable QImage _defaultIcon; // on-demand
 
 	std::optional<HistoryItem*> _lastMessage;
@@ -32,6 +32,8 @@ namespace Data {
 namespace {
 
 constexpr auto kReadRequestTimeout = 3 * crl::time(1000);
+constexpr auto kMaxReadRequestsInFlight = 8;
+constexpr auto kReportSendLatencyEach = 100;
 
 } // namespace
 
@@ -282,7 +284,11 @@ void Histories::readInboxTill(
 			).arg(tillId.bare
 			).arg(stillUnread.value_or(-666)));
 		state.willReadWhen = 0;
-		sendReadRequests();
+
+		// Coalesce the sends, so that marking a whole folder as read
+		// rescans the states and fans requests out once per tick
+		// instead of once per peer.
+		_readRequestsTimer.callOnce(0);
 		if (!stillUnread) {
 			return;
 		}
@@ -576,6 +582,11 @@ void Histories::sendReadRequests() {
 		if (!state.willReadTill) {
 			DEBUG_LOG(("Reading: skipping zero till."));
 			continue;
+		} else if (_readRequestsSent >= kMaxReadRequestsInFlight) {
+			// The fan-out is capped, the next batch goes out as soon
+			// as one of the in-flight read requests finishes.
+			DEBUG_LOG(("Reading: in-flight limit reached."));
+			break;
 		} else if (state.willReadWhen <= now) {
 			DEBUG_LOG(("Reading: sending with till %1."
 				).arg(state.willReadTill.bare));
@@ -598,12 +609,15 @@ void Histories::sendReadRequest(not_null<History*> history, State &state) {
 	const auto tillId = state.sentReadTill = base::take(state.willReadTill);
 	state.willReadWhen = 0;
 	state.sentReadDone = false;
+	++_readRequestsSent;
 	DEBUG_LOG(("Reading: sending request now with till %1."
 		).arg(tillId.bare));
 	sendRequest(history, RequestType::ReadInbox, [=](Fn<void()> finish) {
 		DEBUG_LOG(("Reading: sending request invoked with till %1."
 			).arg(tillId.bare));
 		const auto finished = [=] {
+			--_readRequestsSent;
+
 			const auto state = lookup(history);
 			Assert(state != nullptr);
 
@@ -875,6 +889,10 @@ void Histories::deleteMessages(const MessageIdsList &ids, bool revoke) {
 		}).send();
 	}
 
+	// When a selection of hundreds of messages is removed, the last message
+	// may be recomputed and re-requested after every single destroy, so
+	// collect the affected histories and refresh each of them only once.
+	auto lastMessageChanged = base::flat_set<not_null<History*>>();
 	for (const auto item : remove) {
 		const auto history = item->history();
 		const auto wasLast = (history->lastMessage() == item);
@@ -882,9 +900,12 @@ void Histories::deleteMessages(const MessageIdsList &ids, bool revoke) {
 		item->destroy();
 
 		if (wasLast || wasInChats) {
-			history->requestChatListMessage();
+			lastMessageChanged.emplace(history);
 		}
 	}
+	for (const auto &history : lastMessageChanged) {
+		history->requestChatListMessage();
+	}
 }
 
 int Histories::sendRequest(
@@ -1005,22 +1026,26 @@ int Histories::sendPreparedMessage(
 		.topicRootId = convertTopicReplyToId(history, replyTo.topicRootId),
 		.quoteOffset = replyTo.quoteOffset,
 	};
+	const auto queuedAt = crl::now();
 	return v::match(message(history, realReplyTo), [&](const auto &request) {
 		const auto type = RequestType::Send;
 		return sendRequest(history, type, [=](Fn<void()> finish) {
 			const auto session = &_owner->session();
 			const auto api = &session->api();
+			const auto sentAt = crl::now();
 			history->sendRequestId = api->request(
 				base::duplicate(request)
 			).done([=](
 					const MTPUpdates &result,
 					const MTP::Response &response) {
+				registerSendLatency(queuedAt, sentAt);
 				api->applyUpdates(result, randomId);
 				done(result, response);
 				finish();
 			}).fail([=](
 					const MTP::Error &error,
 					const MTP::Response &response) {
+				registerSendLatency(queuedAt, sentAt);
 				fail(error, response);
 				finish();
 			}).afterRequest(
@@ -1031,6 +1056,32 @@ int Histories::sendPreparedMessage(
 	});
 }
 
+void Histories::registerSendLatency(crl::time queuedAt, crl::time sentAt) {
+	const auto now = crl::now();
+	const auto queueWait = sentAt - queuedAt;
+	const auto network = now - sentAt;
+	_sendQueueWaitTotal += queueWait;
+	accumulate_max(_sendQueueWaitMax, queueWait);
+	_sendNetworkTotal += network;
+	accumulate_max(_sendNetworkMax, network);
+	if (++_sendLatencyCount < kReportSendLatencyEach) {
+		return;
+	}
+	// Splits slow sends into local queueing (waiting for the previous
+	// request to the same history) and the request round trip, which the
+	// MTP session logs break down further into serialize / write / ack.
+	DEBUG_LOG(("Histories: Last %1 sends, queue wait avg %2ms max %3ms, "
+		"round trip avg %4ms max %5ms."
+		).arg(_sendLatencyCount
+		).arg(_sendQueueWaitTotal / _sendLatencyCount
+		).arg(_sendQueueWaitMax
+		).arg(_sendNetworkTotal / _sendLatencyCount
+		).arg(_sendNetworkMax));
+	_sendLatencyCount = 0;
+	_sendQueueWaitTotal = _sendQueueWaitMax = 0;
+	_sendNetworkTotal = _sendNetworkMax = 0;
+}
+
 void Histories::checkTopicCreated(FullMsgId rootId, MsgId realRoot) {
 	const auto i = _creatingTopics.find(rootId);
 	if (i != end(_creatingTopics)) {
@@ -207,6 +207,7 @@ private:
 		MsgId rootId) const;
 	void sendCreateTopicRequest(not_null<History*> history, MsgId rootId);
 	void cancelDelayedByTopicRequest(int id);
+	void registerSendLatency(crl::time queuedAt, crl::time sentAt);
 
 	const not_null<Session*> _owner;
 
@@ -215,6 +216,7 @@ private:
 	base::flat_map<int, not_null<History*>> _historyByRequest;
 	int _requestAutoincrement = 0;
 	base::Timer _readRequestsTimer;
+	int _readRequestsSent = 0;
 
 	base::flat_set<not_null<Data::Folder*>> _dialogFolderRequests;
 	base::flat_map<
@@ -236,6 +238,12 @@ private:
 	base::flat_map<FullMsgId, MsgId> _createdTopicIds;
 	base::flat_set<mtpRequestId> _creatingTopicRequests;
 
+	int _sendLatencyCount = 0;
+	crl::time _sendQueueWaitTotal = 0;
+	crl::time _sendQueueWaitMax = 0;
+	crl::time _sendNetworkTotal = 0;
+	crl::time _sendNetworkMax = 0;
+
 };
 
 } // namespace Data
@@ -43,6 +43,10 @@ struct MessageReaction {
 	ReactionId id;
 	int count = 0;
 	bool my = false;
+
+	friend inline bool operator==(
+		const MessageReaction &a,
+		const MessageReaction &b) = default;
 };
 
 [[nodiscard]] QString SearchTagToQuery(const ReactionId &tagId);
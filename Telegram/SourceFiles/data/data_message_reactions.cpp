@@ -42,6 +42,24 @@ constexpr auto kRecentReactionsLimit = 40;
 constexpr auto kMyTagsRequestTimeout = crl::time(1000);
 constexpr auto kTopRequestDelay = 60 * crl::time(1000);
 constexpr auto kTopReactionsLimit = 14;
+constexpr auto kInternedStatesCleanupEvery = 256;
+
+[[nodiscard]] uint64 ListStateHash(const std::vector<MessageReaction> &list) {
+	auto result = uint64();
+	const auto mix = [&](uint64 value) {
+		result ^= value
+			+ 0x9E3779B97F4A7C15ULL
+			+ (result << 6)
+			+ (result >> 2);
+	};
+	for (const auto &one : list) {
+		mix(one.id.custom());
+		mix(qHash(one.id.emoji()));
+		mix(uint64(one.count));
+		mix(one.my ? 1 : 0);
+	}
+	return result;
+}
 
 [[nodiscard]] QString ReactionIdToLog(const ReactionId &id) {
 	if (const auto custom = id.custom()) {
@@ -1221,6 +1239,38 @@ Reaction *Reactions::lookupTemporary(const ReactionId &id) {
 	return nullptr;
 }
 
+auto Reactions::internListState(std::vector<MessageReaction> &&list)
+-> std::shared_ptr<const std::vector<MessageReaction>> {
+	Expects(!list.empty());
+
+	const auto key = ListStateHash(list);
+	const auto i = _internedStates.find(key);
+	if (i != end(_internedStates)) {
+		if (auto strong = i->second.lock()) {
+			if (*strong == list) {
+				return strong;
+			}
+			// A real hash collision, let the states live separately.
+			return std::make_shared<const std::vector<MessageReaction>>(
+				std::move(list));
+		}
+	}
+	if (++_internedStatesTillCleanup >= kInternedStatesCleanupEvery) {
+		_internedStatesTillCleanup = 0;
+		for (auto j = begin(_internedStates); j != end(_internedStates);) {
+			if (j->second.expired()) {
+				j = _internedStates.erase(j);
+			} else {
+				++j;
+			}
+		}
+	}
+	auto result = std::make_shared<const std::vector<MessageReaction>>(
+		std::move(list));
+	_internedStates[key] = result;
+	return result;
+}
+
 rpl::producer<std::vector<Reaction>> Reactions::myTagsValue(
 		SavedSublist *sublist) {
 	refreshMyTags(sublist);
@@ -1334,13 +1384,14 @@ void MessageReactions::add(const ReactionId &id, bool addToRecent) {
 	if (ranges::contains(chosen(), id)) {
 		return;
 	}
+	auto reactions = copyList();
 	auto my = 0;
 	const auto tags = _item->reactionsAreTags();
 	if (tags) {
 		const auto sublist = _item->savedSublist();
 		history->owner().reactions().incrementMyTag(id, sublist);
 	}
-	_list.erase(ranges::remove_if(_list, [&](MessageReaction &one) {
+	reactions.erase(ranges::remove_if(reactions, [&](MessageReaction &one) {
 		const auto removing = one.my && (my == myLimit || ++my == myLimit);
 		if (!removing) {
 			return false;
@@ -1366,7 +1417,7 @@ void MessageReactions::add(const ReactionId &id, bool addToRecent) {
 			history->owner().reactions().decrementMyTag(one.id, sublist);
 		}
 		return removed;
-	}), end(_list));
+	}), end(reactions));
 	const auto peer = history->peer;
 	if (_item->canViewReactions() || peer->isUser()) {
 		auto &list = _recent[id];
@@ -1376,14 +1427,15 @@ void MessageReactions::add(const ReactionId &id, bool addToRecent) {
 			.my = true,
 		});
 	}
-	const auto i = ranges::find(_list, id, &MessageReaction::id);
-	if (i != end(_list)) {
+	const auto i = ranges::find(reactions, id, &MessageReaction::id);
+	if (i != end(reactions)) {
 		i->my = true;
 		++i->count;
-		std::rotate(i, i + 1, end(_list));
+		std::rotate(i, i + 1, end(reactions));
 	} else {
-		_list.push_back({ .id = id, .count = 1, .my = true });
+		reactions.push_back({ .id = id, .count = 1, .my = true });
 	}
+	setList(std::move(reactions));
 	auto &owner = history->owner();
 	owner.reactions().send(_item, addToRecent);
 	owner.notifyItemDataChange(_item);
@@ -1392,9 +1444,10 @@ void MessageReactions::add(const ReactionId &id, bool addToRecent) {
 void MessageReactions::remove(const ReactionId &id) {
 	const auto history = _item->history();
 	const auto self = history->session().user();
-	const auto i = ranges::find(_list, id, &MessageReaction::id);
+	auto reactions = copyList();
+	const auto i = ranges::find(reactions, id, &MessageReaction::id);
 	const auto j = _recent.find(id);
-	if (i == end(_list)) {
+	if (i == end(reactions)) {
 		Assert(j == end(_recent));
 		return;
 	} else if (!i->my) {
@@ -1406,8 +1459,9 @@ void MessageReactions::remove(const ReactionId &id) {
 	const auto tags = _item->reactionsAreTags();
 	const auto removed = !--i->count;
 	if (removed) {
-		_list.erase(i);
+		reactions.erase(i);
 	}
+	setList(std::move(reactions));
 	if (j != end(_recent)) {
 		if (removed) {
 			j->second.clear();
@@ -1439,13 +1493,17 @@ bool MessageReactions::checkIfChanged(
 		// We'll apply non-stale data from the request response.
 		return false;
 	}
+	const auto &reactions = current();
 	auto existing = base::flat_set<ReactionId>();
 	for (const auto &count : list) {
 		const auto changed = count.match([&](const MTPDreactionCount &data) {
 			const auto id = ReactionFromMTP(data.vreaction());
 			const auto nowCount = data.vcount().v;
-			const auto i = ranges::find(_list, id, &MessageReaction::id);
-			const auto wasCount = (i != end(_list)) ? i->count : 0;
+			const auto i = ranges::find(
+				reactions,
+				id,
+				&MessageReaction::id);
+			const auto wasCount = (i != end(reactions)) ? i->count : 0;
 			if (wasCount != nowCount) {
 				return true;
 			}
@@ -1456,7 +1514,7 @@ bool MessageReactions::checkIfChanged(
 			return true;
 		}
 	}
-	for (const auto &reaction : _list) {
+	for (const auto &reaction : reactions) {
 		if (!existing.contains(reaction.id)) {
 			return true;
 		}
@@ -1465,7 +1523,7 @@ bool MessageReactions::checkIfChanged(
 	for (const auto &reaction : recent) {
 		reaction.match([&](const MTPDmessagePeerReaction &data) {
 			const auto id = ReactionFromMTP(data.vreaction());
-			if (!ranges::contains(_list, id, &MessageReaction::id)) {
+			if (!ranges::contains(reactions, id, &MessageReaction::id)) {
 				return;
 			}
 			const auto peerId = peerFromMTP(data.vpeer_id());
@@ -1500,6 +1558,7 @@ bool MessageReactions::change(
 		return false;
 	}
 	auto changed = false;
+	auto reactions = copyList();
 	auto existing = base::flat_set<ReactionId>();
 	auto order = base::flat_map<ReactionId, int>();
 	for (const auto &count : list) {
@@ -1509,11 +1568,14 @@ bool MessageReactions::change(
 			if (!min && chosen) {
 				order[id] = chosen->v;
 			}
-			const auto i = ranges::find(_list, id, &MessageReaction::id);
+			const auto i = ranges::find(
+				reactions,
+				id,
+				&MessageReaction::id);
 			const auto nowCount = data.vcount().v;
-			if (i == end(_list)) {
+			if (i == end(reactions)) {
 				changed = true;
-				_list.push_back({
+				reactions.push_back({
 					.id = id,
 					.count = nowCount,
 					.my = (!min && chosen)
@@ -1536,7 +1598,7 @@ bool MessageReactions::change(
 		};
 		const auto correctOrder = [&] {
 			auto previousOrder = minimal;
-			for (const auto &reaction : _list) {
+			for (const auto &reaction : reactions) {
 				const auto nowOrder = proj(reaction);
 				if (nowOrder < previousOrder) {
 					return false;
@@ -1547,14 +1609,14 @@ bool MessageReactions::change(
 		}();
 		if (!correctOrder) {
 			changed = true;
-			ranges::sort(_list, std::less(), proj);
+			ranges::sort(reactions, std::less(), proj);
 		}
 	}
-	if (_list.size() != existing.size()) {
+	if (reactions.size() != existing.size()) {
 		changed = true;
-		for (auto i = begin(_list); i != end(_list);) {
+		for (auto i = begin(reactions); i != end(reactions);) {
 			if (!existing.contains(i->id)) {
-				i = _list.erase(i);
+				i = reactions.erase(i);
 			} else {
 				++i;
 			}
@@ -1564,8 +1626,11 @@ bool MessageReactions::change(
 	for (const auto &reaction : recent) {
 		reaction.match([&](const MTPDmessagePeerReaction &data) {
 			const auto id = ReactionFromMTP(data.vreaction());
-			const auto i = ranges::find(_list, id, &MessageReaction::id);
-			if (i == end(_list)) {
+			const auto i = ranges::find(
+				reactions,
+				id,
+				&MessageReaction::id);
+			if (i == end(reactions)) {
 				return;
 			}
 			auto &list = parsed[id];
@@ -1587,11 +1652,30 @@ bool MessageReactions::change(
 		_recent = std::move(parsed);
 		changed = true;
 	}
+	setList(std::move(reactions));
 	return changed;
 }
 
+const std::vector<MessageReaction> &MessageReactions::current() const {
+	static const auto empty = std::vector<MessageReaction>();
+	return _list ? *_list : empty;
+}
+
+std::vector<MessageReaction> MessageReactions::copyList() const {
+	return _list ? *_list : std::vector<MessageReaction>();
+}
+
+void MessageReactions::setList(std::vector<MessageReaction> &&list) {
+	if (list.empty()) {
+		_list = nullptr;
+	} else {
+		_list = _item->history()->owner().reactions().internListState(
+			std::move(list));
+	}
+}
+
 const std::vector<MessageReaction> &MessageReactions::list() const {
-	return _list;
+	return current();
 }
 
 auto MessageReactions::recent() const
@@ -1600,7 +1684,7 @@ auto MessageReactions::recent() const
 }
 
 bool MessageReactions::empty() const {
-	return _list.empty();
+	return current().empty();
 }
 
 bool MessageReactions::hasUnread() const {
@@ -1621,7 +1705,7 @@ void MessageReactions::markRead() {
 }
 
 std::vector<ReactionId> MessageReactions::chosen() const {
-	return _list
+	return current()
 		| ranges::views::filter(&MessageReaction::my)
 		| ranges::views::transform(&MessageReaction::id)
 		| ranges::to_vector;
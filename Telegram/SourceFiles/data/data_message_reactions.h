@@ -129,6 +129,11 @@ public:
 	void clearTemporary();
 	[[nodiscard]] Reaction *lookupTemporary(const ReactionId &id);
 
+	// Reaction-set states repeat across items a lot, intern them so a
+	// structurally identical list is allocated only once per session.
+	[[nodiscard]] auto internListState(std::vector<MessageReaction> &&list)
+		-> std::shared_ptr<const std::vector<MessageReaction>>;
+
 	[[nodiscard]] rpl::producer<std::vector<Reaction>> myTagsValue(
 		SavedSublist *sublist = nullptr);
 
@@ -255,6 +260,11 @@ private:
 	// Otherwise we could use flat_map<DocumentId, unique_ptr<Reaction>>.
 	std::map<DocumentId, Reaction> _temporary;
 
+	base::flat_map<
+		uint64,
+		std::weak_ptr<const std::vector<MessageReaction>>> _internedStates;
+	int _internedStatesTillCleanup = 0;
+
 	base::Timer _topRefreshTimer;
 	mtpRequestId _topRequestId = 0;
 	uint64 _topHash = 0;
@@ -327,9 +337,13 @@ public:
 	void markRead();
 
 private:
+	[[nodiscard]] const std::vector<MessageReaction> &current() const;
+	[[nodiscard]] std::vector<MessageReaction> copyList() const;
+	void setList(std::vector<MessageReaction> &&list);
+
 	const not_null<HistoryItem*> _item;
 
-	std::vector<MessageReaction> _list;
+	std::shared_ptr<const std::vector<MessageReaction>> _list;
 	base::flat_map<ReactionId, std::vector<RecentReaction>> _recent;
 
 };
@@ -0,0 +1,116 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/data_message_store.h"
+
+namespace Data {
+namespace {
+
+constexpr auto kDefaultViewsBudget = 64 * 1024;
+
+} // namespace
+
+MessageStore::MessageStore()
+: _viewsBudget(kDefaultViewsBudget) {
+}
+
+MessageStore::Shard &MessageStore::shardFor(PeerId peerId) {
+	return _shards[peerId.value % kShardCount];
+}
+
+const MessageStore::Shard &MessageStore::shardFor(PeerId peerId) const {
+	return _shards[peerId.value % kShardCount];
+}
+
+const MessageStore::Messages *MessageStore::list(PeerId peerId) const {
+	const auto &shard = shardFor(peerId);
+	const auto i = shard.lists.find(peerId);
+	return (i != end(shard.lists)) ? &i->second : nullptr;
+}
+
+not_null<MessageStore::Messages*> MessageStore::listForInsert(
+		PeerId peerId) {
+	touch(peerId);
+	return &shardFor(peerId).lists[peerId];
+}
+
+void MessageStore::remove(PeerId peerId, MsgId itemId) {
+	auto &shard = shardFor(peerId);
+	const auto i = shard.lists.find(peerId);
+	if (i == end(shard.lists)) {
+		return;
+	}
+	i->second.erase(itemId);
+	if (i->second.empty()) {
+		shard.lists.erase(i);
+		const auto j = _recentPlaces.find(peerId);
+		if (j != end(_recentPlaces)) {
+			_recent.erase(j->second);
+			_recentPlaces.erase(j);
+		}
+	}
+}
+
+void MessageStore::touch(PeerId peerId) {
+	const auto i = _recentPlaces.find(peerId);
+	if (i != end(_recentPlaces)) {
+		_recent.splice(begin(_recent), _recent, i->second);
+	} else {
+		_recent.push_front(peerId);
+		_recentPlaces.emplace(peerId, begin(_recent));
+	}
+}
+
+void MessageStore::clear() {
+	for (auto &shard : _shards) {
+		base::take(shard.lists);
+	}
+	_recent.clear();
+	_recentPlaces.clear();
+}
+
+void MessageStore::setViewsBudget(int budget) {
+	Expects(budget > 0);
+
+	_viewsBudget = budget;
+}
+
+int MessageStore::itemsCount() const {
+	auto result = 0;
+	for (const auto &shard : _shards) {
+		for (const auto &[peerId, list] : shard.lists) {
+			result += int(list.size());
+		}
+	}
+	return result;
+}
+
+std::vector<PeerId> MessageStore::collectCold(
+		Fn<int(PeerId)> loadedCount) const {
+	auto total = 0;
+	for (const auto &peerId : _recent) {
+		total += loadedCount(peerId);
+	}
+	auto excess = total - _viewsBudget;
+	if (excess <= 0) {
+		return {};
+	}
+	auto result = std::vector<PeerId>();
+	for (auto i = _recent.rbegin(); i != _recent.rend(); ++i) {
+		if (excess <= 0) {
+			break;
+		}
+		const auto loaded = loadedCount(*i);
+		if (loaded > 0) {
+			excess -= loaded;
+			result.push_back(*i);
+		}
+	}
+	return result;
+}
+
+} // namespace Data
@@ -0,0 +1,61 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+class HistoryItem;
+
+namespace Data {
+
+// Sharded per-peer lookup for parsed HistoryItem objects. Peers are spread
+// over a fixed set of shards by id so that a single huge hash map never has
+// to rehash all messages of the session at once, and a recency list over
+// peers lets the session unload the parsed tier for peers that have not
+// been touched in a long time.
+class MessageStore final {
+public:
+	using Messages = std::unordered_map<MsgId, not_null<HistoryItem*>>;
+
+	MessageStore();
+
+	[[nodiscard]] const Messages *list(PeerId peerId) const;
+	[[nodiscard]] not_null<Messages*> listForInsert(PeerId peerId);
+	void remove(PeerId peerId, MsgId itemId);
+	void touch(PeerId peerId);
+	void clear();
+
+	// Budget is an approximate count of loaded history views kept for
+	// cold peers. Unloading a history clears its view blocks while the
+	// parsed items stay owned, so views are what unloading can free.
+	void setViewsBudget(int budget);
+	[[nodiscard]] int itemsCount() const;
+
+	// Least-recently-touched peers that should be unloaded to get the
+	// total loaded view count back under the configured budget. The
+	// views are counted by the caller through loadedCount, peers with
+	// nothing loaded are skipped.
+	[[nodiscard]] std::vector<PeerId> collectCold(
+		Fn<int(PeerId)> loadedCount) const;
+
+private:
+	static constexpr auto kShardCount = 16;
+
+	struct Shard {
+		std::unordered_map<PeerId, Messages> lists;
+	};
+
+	[[nodiscard]] Shard &shardFor(PeerId peerId);
+	[[nodiscard]] const Shard &shardFor(PeerId peerId) const;
+
+	std::array<Shard, kShardCount> _shards;
+	std::list<PeerId> _recent; // Most recently touched in front.
+	std::unordered_map<PeerId, std::list<PeerId>::iterator> _recentPlaces;
+	int _viewsBudget = 0;
+
+};
+
+} // namespace Data
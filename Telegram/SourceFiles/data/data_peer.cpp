@@ -746,8 +746,9 @@ void PeerData::fillNames() {
 
 	const auto namesList = TextUtilities::PrepareSearchWords(toIndex);
 	for (const auto &name : namesList) {
-		_nameWords.insert(name);
-		_nameFirstLetters.insert(name[0]);
+		const auto word = owner().internNameWord(name);
+		_nameWords.insert(word);
+		_nameFirstLetters.insert(word[0]);
 	}
 }
 
@@ -0,0 +1,146 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/data_search_index.h"
+
+#include "data/data_session.h"
+#include "history/history.h"
+#include "history/history_item.h"
+
+namespace Data {
+namespace {
+
+constexpr auto kMaxTokensPerMessage = 64;
+constexpr auto kMaxTokenLength = 16;
+
+} // namespace
+
+SearchIndex::SearchIndex(not_null<Session*> owner)
+: _owner(owner) {
+}
+
+std::vector<QString> SearchIndex::Tokenize(const QString &text) {
+	auto result = std::vector<QString>();
+	auto token = QString();
+	const auto push = [&] {
+		if (!token.isEmpty()
+			&& (result.size() < kMaxTokensPerMessage)
+			&& !ranges::contains(result, token)) {
+			result.push_back(base::take(token));
+		} else {
+			token = QString();
+		}
+	};
+	for (const auto &ch : text.toLower()) {
+		if (ch.isLetterOrNumber()) {
+			if (token.size() < kMaxTokenLength) {
+				token.append(ch);
+			}
+		} else {
+			push();
+		}
+	}
+	push();
+	return result;
+}
+
+void SearchIndex::Unindex(PeerIndex &index, MsgId itemId) {
+	const auto i = index.tokens.find(itemId);
+	if (i == end(index.tokens)) {
+		return;
+	}
+	for (const auto &token : i->second) {
+		const auto j = index.byToken.find(token);
+		if (j != end(index.byToken)) {
+			j->second.remove(itemId);
+			if (j->second.empty()) {
+				index.byToken.erase(j);
+			}
+		}
+	}
+	index.tokens.erase(i);
+}
+
+void SearchIndex::add(not_null<const HistoryItem*> item) {
+	auto tokens = Tokenize(item->originalText().text);
+	if (tokens.empty()) {
+		remove(item);
+		return;
+	}
+	auto &index = _byPeer[item->history()->peer->id];
+
+	// An edited message is re-added, drop the previous revision first.
+	Unindex(index, item->id);
+	for (const auto &token : tokens) {
+		index.byToken[token].emplace(item->id);
+	}
+	index.tokens[item->id] = std::move(tokens);
+}
+
+void SearchIndex::remove(not_null<const HistoryItem*> item) {
+	const auto i = _byPeer.find(item->history()->peer->id);
+	if (i == end(_byPeer)) {
+		return;
+	}
+	Unindex(i->second, item->id);
+	if (i->second.tokens.empty()) {
+		_byPeer.erase(i);
+	}
+}
+
+MessageIdsList SearchIndex::query(
+		PeerId peerId,
+		const QString &query,
+		int limit) const {
+	const auto tokens = Tokenize(query);
+	const auto i = _byPeer.find(peerId);
+	if (tokens.empty() || (limit <= 0) || (i == end(_byPeer))) {
+		return {};
+	}
+	const auto &byToken = i->second.byToken;
+	auto candidates = base::flat_set<MsgId>();
+	auto first = true;
+	for (const auto &token : tokens) {
+		auto matched = base::flat_set<MsgId>();
+		for (auto j = byToken.lower_bound(token)
+			; (j != end(byToken)) && j->first.startsWith(token)
+			; ++j) {
+			for (const auto id : j->second) {
+				matched.emplace(id);
+			}
+		}
+		if (first) {
+			candidates = std::move(matched);
+			first = false;
+		} else {
+			for (auto k = begin(candidates); k != end(candidates);) {
+				if (matched.contains(*k)) {
+					++k;
+				} else {
+					k = candidates.erase(k);
+				}
+			}
+		}
+		if (candidates.empty()) {
+			return {};
+		}
+	}
+	auto result = MessageIdsList();
+	for (auto k = end(candidates); k != begin(candidates);) {
+		const auto item = _owner->message(peerId, *--k);
+		if (!item) {
+			continue;
+		}
+		result.push_back(item->fullId());
+		if (int(result.size()) >= limit) {
+			break;
+		}
+	}
+	return result;
+}
+
+} // namespace Data
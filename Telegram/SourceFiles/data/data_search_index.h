@@ -0,0 +1,51 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+class HistoryItem;
+
+namespace Data {
+
+class Session;
+
+// In-memory tokenized prefix index over the messages currently loaded
+// in the session, for instant local search results while the server
+// round-trip is still in flight. Nothing is persisted - entries follow
+// the lifetime of the loaded items. The tokens actually indexed are
+// remembered per message, so editing or removing a message drops
+// exactly what was added for its previous revision.
+class SearchIndex final {
+public:
+	explicit SearchIndex(not_null<Session*> owner);
+
+	void add(not_null<const HistoryItem*> item);
+	void remove(not_null<const HistoryItem*> item);
+
+	[[nodiscard]] MessageIdsList query(
+		PeerId peerId,
+		const QString &query,
+		int limit) const;
+
+	[[nodiscard]] static std::vector<QString> Tokenize(
+		const QString &text);
+
+private:
+	struct PeerIndex {
+		base::flat_map<QString, base::flat_set<MsgId>> byToken;
+		base::flat_map<MsgId, std::vector<QString>> tokens;
+	};
+
+	static void Unindex(PeerIndex &index, MsgId itemId);
+
+	const not_null<Session*> _owner;
+
+	base::flat_map<PeerId, PeerIndex> _byPeer;
+
+};
+
+} // namespace Data
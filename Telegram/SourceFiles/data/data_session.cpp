@@ -19,12 +19,14 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "core/core_settings.h"
 #include "core/mime_type.h" // Core::IsMimeSticker
+#include "core/tracepoints.h"
 #include "ui/image/image_location_factory.h" // Images::FromPhotoSize
 #include "ui/text/format_values.h" // Ui::FormatPhone
 #include "export/export_manager.h"
 #include "export/view/export_view_panel_controller.h"
 #include "mtproto/mtproto_config.h"
 #include "window/notifications_manager.h"
+#include "window/window_session_controller.h"
 #include "history/history.h"
 #include "history/history_item_components.h"
 #include "history/view/media/history_view_media.h"
@@ -70,6 +72,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_streaming.h"
 #include "data/data_media_rotation.h"
 #include "data/data_histories.h"
+#include "data/data_search_index.h"
 #include "data/data_peer_values.h"
 #include "data/data_premium_limits.h"
 #include "data/data_forum.h"
@@ -85,6 +88,10 @@ namespace {
 
 using ViewElement = HistoryView::Element;
 
+constexpr auto kUnloadColdMessagesEach = 5 * 60 * crl::time(1000);
+constexpr auto kMemoryBreakdownEach = 10 * 60 * crl::time(1000);
+constexpr auto kTranslationsCacheLimit = 1024;
+
 // s: box 100x100
 // m: box 320x320
 // x: box 800x800
@@ -246,12 +253,15 @@ Session::Session(not_null<Main::Session*> session)
 ) | rpl::map([limits = Data::LevelLimits(session)] {
 	return limits.groupTranscribeLevelMin();
 }))
+, _unreadBadgeChangedNotify([=] { _unreadBadgeChanges.fire({}); })
 , _chatsList(
 	session,
 	FilterId(),
 	maxPinnedChatsLimitValue(nullptr))
 , _contactsList(Dialogs::SortMode::Name)
 , _contactsNoChatsList(Dialogs::SortMode::Name)
+, _coldMessagesTimer([=] { unloadColdMessages(); })
+, _memoryBreakdownTimer([=] { logMemoryBreakdown(); })
 , _ttlCheckTimer([=] { checkTTLs(); })
 , _selfDestructTimer([=] { checkSelfDestructItems(); })
 , _pollsClosingTimer([=] { checkPollsClosings(); })
@@ -263,6 +273,7 @@ Session::Session(not_null<Main::Session*> session)
 , _streaming(std::make_unique<Streaming>(this))
 , _mediaRotation(std::make_unique<MediaRotation>())
 , _histories(std::make_unique<Histories>(this))
+, _searchIndex(std::make_unique<SearchIndex>(this))
 , _stickers(std::make_unique<Stickers>(this))
 , _reactions(std::make_unique<Reactions>(this))
 , _emojiStatuses(std::make_unique<EmojiStatuses>(this))
@@ -292,6 +303,9 @@ Session::Session(not_null<Main::Session*> session)
 	setupPeerNameViewer();
 	setupUserIsContactViewer();
 
+	_coldMessagesTimer.callEach(kUnloadColdMessagesEach);
+	_memoryBreakdownTimer.callEach(kMemoryBreakdownEach);
+
 	_chatsList.unreadStateChanges(
 	) | rpl::start_with_next([=] {
 		notifyUnreadBadgeChanged();
@@ -402,7 +416,7 @@ void Session::clear() {
 	_shortcutMessages = nullptr;
 	_sponsoredMessages = nullptr;
 	_dependentMessages.clear();
-	base::take(_messages);
+	_messages.clear();
 	base::take(_nonChannelMessages);
 	_messageByRandomId.clear();
 	_sentMessagesData.clear();
@@ -2319,7 +2333,10 @@ void Session::updateEditedMessage(const MTPMessage &data) {
 void Session::processMessages(
 		const QVector<MTPMessage> &data,
 		NewMessageType type) {
-	auto indices = base::flat_map<uint64, int>();
+	// Group the messages per peer, so each history receives its portion
+	// as one ascending-id run instead of interleaving several histories
+	// when a difference covers many chats at once.
+	auto indices = base::flat_map<std::pair<uint64, uint64>, int>();
 	for (int i = 0, l = data.size(); i != l; ++i) {
 		const auto &message = data[i];
 		if (message.type() == mtpc_message) {
@@ -2331,8 +2348,18 @@ void Session::processMessages(
 			}
 		}
 		const auto id = IdFromMessage(message); // Only 32 bit values here.
-		indices.emplace((uint64(uint32(id.bare)) << 32) | uint64(i), i);
-	}
+		indices.emplace(
+			std::pair(
+				PeerFromMessage(message).value,
+				(uint64(uint32(id.bare)) << 32) | uint64(i)),
+			i);
+	}
+	const auto wasIngesting = std::exchange(
+		_ingestingMessagesBatch,
+		indices.size() > 1);
+	const auto guard = gsl::finally([&] {
+		_ingestingMessagesBatch = wasIngesting;
+	});
 	for (const auto &[position, index] : indices) {
 		addNewMessage(
 			data[index],
@@ -2369,13 +2396,98 @@ void Session::processExistingMessages(
 }
 
 const Session::Messages *Session::messagesList(PeerId peerId) const {
-	const auto i = _messages.find(peerId);
-	return (i != end(_messages)) ? &i->second : nullptr;
+	return _messages.list(peerId);
 }
 
 auto Session::messagesListForInsert(PeerId peerId)
 -> not_null<Messages*> {
-	return &_messages[peerId];
+	return _messages.listForInsert(peerId);
+}
+
+void Session::unloadColdMessages() {
+	const auto loadedCount = [&](PeerId peerId) {
+		const auto history = historyLoaded(peerId);
+		if (!history) {
+			return 0;
+		}
+		auto result = 0;
+		for (const auto &block : history->blocks) {
+			result += int(block->messages.size());
+		}
+		return result;
+	};
+	const auto shown = [&](not_null<History*> history) {
+		for (const auto &window : _session->windows()) {
+			if (window->activeChatCurrent().owningHistory() == history) {
+				return true;
+			}
+		}
+		return false;
+	};
+	for (const auto &peerId : _messages.collectCold(loadedCount)) {
+		const auto history = historyLoaded(peerId);
+		if (history
+			&& !history->hasPendingResizedItems()
+			&& !shown(history)) {
+			history->clear(History::ClearType::Unload);
+		}
+	}
+}
+
+void Session::logMemoryBreakdown() const {
+	// Object populations per owner map, so a log from a "the client eats
+	// too much RAM" report shows which subsystem actually grew. Everything
+	// here is an O(1) size() read, cheap enough to sample periodically.
+	DEBUG_LOG(("Memory Info: peers: %1, messages: %2, photos: %3, "
+		"documents: %4, webpages: %5, polls: %6, games: %7, "
+		"bot apps: %8, locations: %9, folders: %10."
+		).arg(_peers.size()
+		).arg(_messages.itemsCount()
+		).arg(_photos.size()
+		).arg(_documents.size()
+		).arg(_webpages.size()
+		).arg(_polls.size()
+		).arg(_games.size()
+		).arg(_botApps.size()
+		).arg(_locations.size()
+		).arg(_folders.size()));
+}
+
+void Session::cacheTranslation(
+		FullMsgId itemId,
+		const QString &toCode,
+		const TextWithEntities &original,
+		const TextWithEntities &translated) {
+	auto key = TranslationCacheKey{
+		.itemId = itemId,
+		.textHash = uint64(qHash(original.text)),
+		.toCode = toCode,
+	};
+	const auto i = _translationsCache.find(key);
+	if (i != end(_translationsCache)) {
+		i->second = translated;
+		return;
+	}
+	while (int(_translationsCache.size()) >= kTranslationsCacheLimit) {
+		_translationsCache.remove(_translationsCacheOrder.front());
+		_translationsCacheOrder.pop_front();
+	}
+	_translationsCacheOrder.push_back(key);
+	_translationsCache.emplace(std::move(key), translated);
+}
+
+std::optional<TextWithEntities> Session::translationFromCache(
+		FullMsgId itemId,
+		const QString &toCode,
+		const TextWithEntities &original) const {
+	const auto i = _translationsCache.find(TranslationCacheKey{
+		.itemId = itemId,
+		.textHash = uint64(qHash(original.text)),
+		.toCode = toCode,
+	});
+	return (i != end(_translationsCache))
+		? std::make_optional(i->second)
+		: std::nullopt;
 }
 
 void Session::registerMessage(not_null<HistoryItem*> item) {
@@ -2388,6 +2500,7 @@ void Session::registerMessage(not_null<HistoryItem*> item) {
 		i->second->destroy();
 	}
 	list->emplace(itemId, item);
+	_searchIndex->add(item);
 
 	if (!peerIsChannel(peerId) && IsServerMsgId(itemId)) {
 		_nonChannelMessages.emplace(itemId, item);
@@ -2515,6 +2628,7 @@ void Session::unregisterMessage(not_null<HistoryItem*> item) {
 		item,
 		Data::MessageUpdate::Flag::Destroyed);
 	groups().unregisterMessage(item);
+	_searchIndex->remove(item);
 	removeDependencyMessage(item);
 	for (auto i = begin(_highlightings); i != end(_highlightings);) {
 		if (i->second == item) {
@@ -2523,7 +2637,7 @@ void Session::unregisterMessage(not_null<HistoryItem*> item) {
 			++i;
 		}
 	}
-	messagesListForInsert(peerId)->erase(itemId);
+	_messages.remove(peerId, itemId);
 
 	if (!peerIsChannel(peerId) && IsServerMsgId(itemId)) {
 		_nonChannelMessages.erase(itemId);
@@ -2550,6 +2664,17 @@ bool Session::suggestToGigagroup(not_null<ChannelData*> group) const {
 	return _suggestToGigagroup.contains(group);
 }
 
+QString Session::internNameWord(const QString &word) {
+	// Search words (first names, usernames, translit copies) repeat a lot
+	// across peers, so equal ones should share a single allocation.
+	const auto i = _internedNameWords.find(word);
+	if (i != end(_internedNameWords)) {
+		return *i;
+	}
+	_internedNameWords.emplace(word);
+	return word;
+}
+
 HistoryItem *Session::message(PeerId peerId, MsgId itemId) const {
 	if (!itemId) {
 		return nullptr;
@@ -2652,11 +2777,16 @@ HistoryItem *Session::addNewMessage(
 		const MTPMessage &data,
 		MessageFlags localFlags,
 		NewMessageType type) {
+	TRACE_SCOPE("Data::Session::addNewMessage");
+
 	const auto peerId = PeerFromMessage(data);
 	if (!peerId) {
 		return nullptr;
 	}
 
+	++(_ingestingMessagesBatch
+		? _messagesIngest.batched
+		: _messagesIngest.individual);
 	const auto result = history(peerId)->addNewMessage(
 		id,
 		data,
@@ -2668,6 +2798,10 @@ HistoryItem *Session::addNewMessage(
 	return result;
 }
 
+MessagesIngestCounters Session::messagesIngestCounters() const {
+	return _messagesIngest;
+}
+
 int Session::unreadBadge() const {
 	return computeUnreadBadge(_chatsList.unreadState());
 }
@@ -2705,7 +2839,10 @@ rpl::producer<> Session::unreadBadgeChanges() const {
 }
 
 void Session::notifyUnreadBadgeChanged() {
-	_unreadBadgeChanges.fire({});
+	// Every observer (tray, titlebar, folders) recounts the badge on
+	// emission, so coalesce the per-chat changes of an update storm
+	// into a single notification per event loop iteration.
+	_unreadBadgeChangedNotify.call();
 }
 
 void Session::updateRepliesReadTill(RepliesReadTillUpdate update) {
@@ -3780,7 +3917,7 @@ not_null<PollData*> Session::processPoll(const MTPDmessageMediaPoll &data) {
 	const auto result = processPoll(data.vpoll());
 	const auto changed = result->applyResults(data.vresults());
 	if (changed) {
-		notifyPollUpdateDelayed(result);
+		notifyPollResultsUpdateDelayed(result);
 	}
 	return result;
 }
@@ -3819,7 +3956,7 @@ void Session::applyUpdate(const MTPDupdateMessagePoll &update) {
 			: i->second.get();
 	}();
 	if (updated && updated->applyResults(update.vresults())) {
-		notifyPollUpdateDelayed(updated);
+		notifyPollResultsUpdateDelayed(updated);
 	}
 }
 
@@ -4178,7 +4315,8 @@ QString Session::findContactPhone(UserId contactId) const {
 bool Session::hasPendingWebPageGamePollNotification() const {
 	return !_webpagesUpdated.empty()
 		|| !_gamesUpdated.empty()
-		|| !_pollsUpdated.empty();
+		|| !_pollsUpdated.empty()
+		|| !_pollResultsUpdated.empty();
 }
 
 void Session::notifyWebPageUpdateDelayed(not_null<WebPageData*> page) {
@@ -4205,6 +4343,14 @@ void Session::notifyPollUpdateDelayed(not_null<PollData*> poll) {
 	}
 }
 
+void Session::notifyPollResultsUpdateDelayed(not_null<PollData*> poll) {
+	const auto invoke = !hasPendingWebPageGamePollNotification();
+	_pollResultsUpdated.insert(poll);
+	if (invoke) {
+		crl::on_main(_session, [=] { sendWebPageGamePollNotifications(); });
+	}
+}
+
 void Session::sendWebPageGamePollNotifications() {
 	for (const auto &page : base::take(_webpagesUpdated)) {
 		_webpageUpdates.fire_copy(page);
@@ -4222,13 +4368,30 @@ void Session::sendWebPageGamePollNotifications() {
 			}
 		}
 	}
-	for (const auto &poll : base::take(_pollsUpdated)) {
+	const auto resized = base::take(_pollsUpdated);
+	for (const auto &poll : resized) {
 		if (const auto i = _pollViews.find(poll); i != _pollViews.end()) {
 			for (const auto &view : i->second) {
 				requestViewResize(view);
 			}
 		}
 	}
+	for (const auto &poll : base::take(_pollResultsUpdated)) {
+		if (resized.contains(poll)) {
+			continue;
+		}
+		// Only the counters / recent voters / solution changed, the
+		// question and answer texts are intact, so the cached layout
+		// stays valid and a repaint is enough - vote storms on popular
+		// quizzes shouldn't re-layout the whole history per update.
+		if (const auto i = _pollViews.find(poll); i != _pollViews.end()) {
+			for (const auto &view : i->second) {
+				if (const auto media = view->media()) {
+					media->updateSharedPollResults();
+				}
+			}
+		}
+	}
 }
 
 rpl::producer<not_null<WebPageData*>> Session::webPageUpdates() const {
@@ -4356,6 +4519,7 @@ void Session::refreshChatListEntry(Dialogs::Key key) {
 	if (!history) {
 		return;
 	}
+	const auto state = _chatsFilters->historyState(history);
 	for (const auto &filter : _chatsFilters->list()) {
 		const auto id = filter.id();
 		if (!id) {
@@ -4363,7 +4527,7 @@ void Session::refreshChatListEntry(Dialogs::Key key) {
 		}
 		const auto filterList = chatsFilters().chatsList(id);
 		auto event = ChatListEntryRefresh{ .key = key, .filterId = id };
-		if (filter.contains(history)) {
+		if (filter.contains(history, state)) {
 			event.existenceChanged = !entry->inChatList(id);
 			if (event.existenceChanged) {
 				entry->addToChatList(id, filterList);
@@ -11,9 +11,12 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "dialogs/dialogs_main_list.h"
 #include "data/data_groups.h"
 #include "data/data_cloud_file.h"
+#include "data/data_message_store.h"
 #include "history/history_location_manager.h"
 #include "base/timer.h"
 
+#include <deque>
+
 class Image;
 class HistoryItem;
 struct WebPageCollage;
@@ -61,6 +64,7 @@ class MediaRotation;
 class Histories;
 class DocumentMedia;
 class PhotoMedia;
+class SearchIndex;
 class Stickers;
 class GroupCall;
 class NotifySettings;
@@ -77,6 +81,14 @@ struct RepliesReadTillUpdate {
 	bool out = false;
 };
 
+// Monitoring surface for update ingestion: how many messages were
+// applied as part of a multi-message batch (difference handling)
+// versus one at a time from the update stream.
+struct MessagesIngestCounters {
+	int64 batched = 0;
+	int64 individual = 0;
+};
+
 class Session final {
 public:
 	using ViewElement = HistoryView::Element;
@@ -125,6 +137,9 @@ public:
 	[[nodiscard]] Histories &histories() const {
 		return *_histories;
 	}
+	[[nodiscard]] SearchIndex &searchIndex() const {
+		return *_searchIndex;
+	}
 	[[nodiscard]] Stickers &stickers() const {
 		return *_stickers;
 	}
@@ -410,9 +425,26 @@ public:
 	[[nodiscard]] bool suggestToGigagroup(
 		not_null<ChannelData*> group) const;
 
+	// Interns a peer name / username word so that equal strings share
+	// one allocation across all the peers of the session.
+	[[nodiscard]] QString internNameWord(const QString &word);
+
 	void registerMessage(not_null<HistoryItem*> item);
 	void unregisterMessage(not_null<HistoryItem*> item);
 
+	// Keeps received message translations across item unloads, so
+	// re-entering a chat doesn't refetch them. Keyed by the original
+	// text hash as well, an edited message misses the stale entry.
+	void cacheTranslation(
+		FullMsgId itemId,
+		const QString &toCode,
+		const TextWithEntities &original,
+		const TextWithEntities &translated);
+	[[nodiscard]] std::optional<TextWithEntities> translationFromCache(
+		FullMsgId itemId,
+		const QString &toCode,
+		const TextWithEntities &original) const;
+
 	void registerMessageTTL(TimeId when, not_null<HistoryItem*> item);
 	void unregisterMessageTTL(TimeId when, not_null<HistoryItem*> item);
 
@@ -425,6 +457,7 @@ public:
 	void processMessages(
 		const MTPVector<MTPMessage> &data,
 		NewMessageType type);
+	[[nodiscard]] MessagesIngestCounters messagesIngestCounters() const;
 	void processExistingMessages(
 		ChannelData *channel,
 		const MTPmessages_Messages &data);
@@ -683,6 +716,7 @@ public:
 	void notifyWebPageUpdateDelayed(not_null<WebPageData*> page);
 	void notifyGameUpdateDelayed(not_null<GameData*> game);
 	void notifyPollUpdateDelayed(not_null<PollData*> poll);
+	void notifyPollResultsUpdateDelayed(not_null<PollData*> poll);
 	[[nodiscard]] bool hasPendingWebPageGamePollNotification() const;
 	void sendWebPageGamePollNotifications();
 	[[nodiscard]] rpl::producer<not_null<WebPageData*>> webPageUpdates() const;
@@ -769,7 +803,7 @@ public:
 	void clearLocalStorage();
 
 private:
-	using Messages = std::unordered_map<MsgId, not_null<HistoryItem*>>;
+	using Messages = MessageStore::Messages;
 
 	void suggestStartExport();
 
@@ -783,6 +817,8 @@ private:
 
 	void scheduleNextTTLs();
 	void checkTTLs();
+	void unloadColdMessages();
+	void logMemoryBreakdown() const;
 
 	int computeUnreadBadge(const Dialogs::UnreadState &state) const;
 	bool computeUnreadBadgeMuted(const Dialogs::UnreadState &state) const;
@@ -933,6 +969,7 @@ private:
 	rpl::event_stream<MegagroupParticipant> _megagroupParticipantAdded;
 	rpl::event_stream<DialogsRowReplacement> _dialogsRowReplacements;
 	rpl::event_stream<ChatListEntryRefresh> _chatListEntryRefreshes;
+	SingleQueuedInvokation _unreadBadgeChangedNotify;
 	rpl::event_stream<> _unreadBadgeChanges;
 	rpl::event_stream<RepliesReadTillUpdate> _repliesReadTillUpdates;
 
@@ -941,7 +978,11 @@ private:
 	Dialogs::IndexedList _contactsNoChatsList;
 
 	MsgId _localMessageIdCounter = StartClientMsgId;
-	std::unordered_map<PeerId, Messages> _messages;
+	MessageStore _messages;
+	base::Timer _coldMessagesTimer;
+	base::Timer _memoryBreakdownTimer;
+	MessagesIngestCounters _messagesIngest;
+	bool _ingestingMessagesBatch = false;
 	std::map<
 		not_null<HistoryItem*>,
 		base::flat_set<not_null<HistoryItem*>>> _dependentMessages;
@@ -953,6 +994,21 @@ private:
 	base::flat_map<uint64, FullMsgId> _messageByRandomId;
 	base::flat_map<uint64, SentData> _sentMessagesData;
 
+	struct TranslationCacheKey {
+		FullMsgId itemId;
+		uint64 textHash = 0;
+		QString toCode;
+
+		friend inline bool operator<(
+				const TranslationCacheKey &a,
+				const TranslationCacheKey &b) {
+			return std::tie(a.itemId, a.textHash, a.toCode)
+				< std::tie(b.itemId, b.textHash, b.toCode);
+		}
+	};
+	base::flat_map<TranslationCacheKey, TextWithEntities> _translationsCache;
+	std::deque<TranslationCacheKey> _translationsCacheOrder;
+
 	base::Timer _selfDestructTimer;
 	std::vector<FullMsgId> _selfDestructItems;
 
@@ -1010,12 +1066,15 @@ private:
 	base::flat_set<not_null<WebPageData*>> _webpagesUpdated;
 	base::flat_set<not_null<GameData*>> _gamesUpdated;
 	base::flat_set<not_null<PollData*>> _pollsUpdated;
+	base::flat_set<not_null<PollData*>> _pollResultsUpdated;
 
 	rpl::event_stream<not_null<WebPageData*>> _webpageUpdates;
 	rpl::event_stream<not_null<ChannelData*>> _channelDifferenceTooLong;
 	rpl::event_stream<not_null<DocumentData*>> _documentLoadProgress;
 	base::flat_set<not_null<ChannelData*>> _suggestToGigagroup;
 
+	base::flat_set<QString> _internedNameWords;
+
 	base::flat_multi_map<TimeId, not_null<PollData*>> _pollsClosings;
 	base::Timer _pollsClosingTimer;
 
@@ -1073,6 +1132,7 @@ private:
 	const std::unique_ptr<Streaming> _streaming;
 	const std::unique_ptr<MediaRotation> _mediaRotation;
 	const std::unique_ptr<Histories> _histories;
+	const std::unique_ptr<SearchIndex> _searchIndex;
 	const std::unique_ptr<Stickers> _stickers;
 	const std::unique_ptr<Reactions> _reactions;
 	const std::unique_ptr<EmojiStatuses> _emojiStatuses;
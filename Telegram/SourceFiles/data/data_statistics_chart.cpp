@@ -34,6 +34,7 @@ void StatisticalChart::measure() {
 		}
 	}
 
+	constexpr auto kMinTierSize = 256;
 	for (auto &line : lines) {
 		if (line.maxValue > maxValue) {
 			maxValue = line.maxValue;
@@ -42,6 +43,20 @@ void StatisticalChart::measure() {
 			minValue = line.minValue;
 		}
 		line.segmentTree = Statistic::SegmentTree(line.y);
+
+		line.downsampled.clear();
+		auto previous = &line.y;
+		while (previous->size() > kMinTierSize) {
+			auto tier = std::vector<int>((previous->size() + 1) / 2);
+			for (auto j = 0, size = int(tier.size()); j != size; ++j) {
+				const auto left = (*previous)[j * 2];
+				tier[j] = (j * 2 + 1 < previous->size())
+					? std::max(left, (*previous)[j * 2 + 1])
+					: left;
+			}
+			line.downsampled.push_back(std::move(tier));
+			previous = &line.downsampled.back();
+		}
 	}
 
 	daysLookup.clear();
@@ -32,6 +32,11 @@ struct StatisticalChart {
 	struct Line final {
 		std::vector<int> y;
 
+		// Downsampled tiers for zoomed-out painting, each tier halves
+		// the point count of the previous one keeping bucket maximums,
+		// so peaks survive however far the chart is zoomed out.
+		std::vector<std::vector<int>> downsampled;
+
 		Statistic::SegmentTree segmentTree;
 		int id = 0;
 		QString idString;
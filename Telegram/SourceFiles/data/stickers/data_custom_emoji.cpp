@@ -279,11 +279,17 @@ Storage::Cache::Key CustomEmojiLoader::cacheKey(
 	if (!baseKey) {
 		return {};
 	}
+	// Renders with an explicit size override must not share an entry with
+	// the tag-sized render: Cache::FromSerialized rejects a size mismatch
+	// and the writer then replaces the entry, so two sizes of one emoji
+	// would evict each other and re-rasterize on every session.
 	return Storage::Cache::Key{
 		baseKey.high,
-		baseKey.low + ChatHelpers::LottieCacheKeyShift(
-			0x0F,
-			LottieSizeFromTag(_tag)),
+		(baseKey.low
+			+ ChatHelpers::LottieCacheKeyShift(
+				0x0F,
+				LottieSizeFromTag(_tag))
+			+ (uint64(_sizeOverride) << 16)),
 	};
 }
 
@@ -837,15 +843,11 @@ void CustomEmojiManager::repaintLater(
 		not_null<Ui::CustomEmoji::Instance*> instance,
 		Ui::CustomEmoji::RepaintRequest request) {
 	auto &bunch = _repaints[request.duration];
+	if (!bunch.scheduled.emplace(instance).second) {
+		// Still waiting for full bunch repaint, don't bump.
+		return;
+	}
 	if (bunch.when < request.when) {
-		if (bunch.when > 0) {
-			for (const auto &already : bunch.instances) {
-				if (already.get() == instance) {
-					// Still waiting for full bunch repaint, don't bump.
-					return;
-				}
-			}
-		}
 		bunch.when = request.when;
 #if 0 // inject-to-on_main
 		_repaintsLastAdded = request.when;
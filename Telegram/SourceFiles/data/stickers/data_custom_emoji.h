@@ -108,6 +108,10 @@ private:
 	struct RepaintBunch {
 		crl::time when = 0;
 		std::vector<base::weak_ptr<Ui::CustomEmoji::Instance>> instances;
+
+		// An instance painted in many views requests the same repaint
+		// once per view, so deduplicate them without scanning the list.
+		base::flat_set<not_null<Ui::CustomEmoji::Instance*>> scheduled;
 	};
 	struct LoaderWithSetId {
 		std::unique_ptr<Ui::CustomEmoji::Loader> loader;
@@ -307,7 +307,7 @@ void Stickers::incrementSticker(not_null<DocumentData*> document) {
 		session().local().writeInstalledStickers();
 	}
 	if (writeRecentStickers) {
-		session().local().writeRecentStickers();
+		session().local().writeRecentStickersDelayed();
 	}
 	notifyRecentUpdated(StickersType::Stickers);
 }
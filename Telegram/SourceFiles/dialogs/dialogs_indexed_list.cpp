@@ -25,6 +25,7 @@ RowsByLetter IndexedList::addToEnd(Key key) {
 		return { row };
 	}
 
+	++_version;
 	auto result = RowsByLetter{ _list.addToEnd(key) };
 	for (const auto &ch : key.entry()->chatListFirstLetters()) {
 		auto j = _index.find(ch);
@@ -41,6 +42,7 @@ Row *IndexedList::addByName(Key key) {
 		return row;
 	}
 
+	++_version;
 	const auto result = _list.addByName(key);
 	for (const auto &ch : key.entry()->chatListFirstLetters()) {
 		auto j = _index.find(ch);
@@ -53,6 +55,7 @@ Row *IndexedList::addByName(Key key) {
 }
 
 void IndexedList::adjustByDate(const RowsByLetter &links) {
+	++_version;
 	_list.adjustByDate(links.main);
 	for (const auto &[ch, row] : links.letters) {
 		if (auto it = _index.find(ch); it != _index.cend()) {
@@ -70,6 +73,7 @@ bool IndexedList::updateHeight(Key key, float64 narrowRatio) {
 }
 
 void IndexedList::moveToTop(Key key) {
+	++_version;
 	if (_list.moveToTop(key)) {
 		for (const auto &ch : key.entry()->chatListFirstLetters()) {
 			if (auto it = _index.find(ch); it != _index.cend()) {
@@ -124,6 +128,7 @@ void IndexedList::adjustByName(
 		const base::flat_set<QChar> &oldLetters) {
 	Expects(_sortMode == SortMode::Name);
 
+	++_version;
 	const auto mainRow = _list.adjustByName(key);
 	if (!mainRow) return;
 
@@ -160,6 +165,7 @@ void IndexedList::adjustNames(
 		FilterId filterId,
 		not_null<History*> history,
 		const base::flat_set<QChar> &oldLetters) {
+	++_version;
 	const auto key = Dialogs::Key(history);
 	auto mainRow = _list.getRow(key);
 	if (!mainRow) return;
@@ -195,6 +201,7 @@ void IndexedList::adjustNames(
 }
 
 void IndexedList::remove(Key key, Row *replacedBy) {
+	++_version;
 	if (_list.remove(key, replacedBy)) {
 		for (const auto &ch : key.entry()->chatListFirstLetters()) {
 			if (const auto it = _index.find(ch); it != _index.cend()) {
@@ -205,6 +212,7 @@ void IndexedList::remove(Key key, Row *replacedBy) {
 }
 
 void IndexedList::clear() {
+	++_version;
 	_list.clear();
 	_index.clear();
 }
@@ -229,12 +237,7 @@ std::vector<not_null<Row*>> IndexedList::filtered(
 		}
 		return result;
 	}();
-	auto result = std::vector<not_null<Row*>>();
-	if (!minimal || minimal->empty()) {
-		return result;
-	}
-	result.reserve(minimal->size());
-	for (const auto &row : *minimal) {
+	const auto rowMatches = [&](not_null<Row*> row) {
 		const auto &nameWords = row->entry()->chatListNameWords();
 		const auto found = [&](const QString &word) {
 			for (const auto &name : nameWords) {
@@ -244,18 +247,58 @@ std::vector<not_null<Row*>> IndexedList::filtered(
 			}
 			return false;
 		};
-		const auto allFound = [&] {
-			for (const auto &word : words) {
-				if (!found(word)) {
-					return false;
+		for (const auto &word : words) {
+			if (!found(word)) {
+				return false;
+			}
+		}
+		return true;
+	};
+	const auto refinesCache = [&] {
+		if (_filterCacheVersion != _version || _filterCacheWords.isEmpty()) {
+			return false;
+		}
+		// Every result of the refined query matched the cached one,
+		// so narrowing the cached results cannot lose matches.
+		for (const auto &was : _filterCacheWords) {
+			const auto prefixesSome = [&] {
+				for (const auto &word : words) {
+					if (word.startsWith(was)) {
+						return true;
+					}
 				}
+				return false;
+			}();
+			if (!prefixesSome) {
+				return false;
 			}
-			return true;
-		}();
-		if (allFound) {
+		}
+		return true;
+	}();
+	auto result = std::vector<not_null<Row*>>();
+	if (refinesCache) {
+		result.reserve(_filterCacheResults.size());
+		for (const auto &row : _filterCacheResults) {
+			if (rowMatches(row)) {
+				result.push_back(row);
+			}
+		}
+		_filterCacheWords = words;
+		_filterCacheResults = result;
+		return result;
+	}
+	if (!minimal || minimal->empty()) {
+		return result;
+	}
+	result.reserve(minimal->size());
+	for (const auto &row : *minimal) {
+		if (rowMatches(row)) {
 			result.push_back(row);
 		}
 	}
+	_filterCacheVersion = _version;
+	_filterCacheWords = words;
+	_filterCacheResults = result;
 	return result;
 }
 
@@ -96,6 +96,15 @@ private:
 	List _list, _empty;
 	base::flat_map<QChar, List> _index;
 
+	// While the user types, each keystroke refines the previous query,
+	// so filtered(words) narrows the previous results instead of
+	// re-walking a whole letter bucket. Any mutation of the list bumps
+	// the version and invalidates the cached results.
+	uint64 _version = 1;
+	mutable uint64 _filterCacheVersion = 0;
+	mutable QStringList _filterCacheWords;
+	mutable std::vector<not_null<Row*>> _filterCacheResults;
+
 };
 
 } // namespace Dialogs
@@ -21,6 +21,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "core/click_handler_types.h"
 #include "core/shortcuts.h"
+#include "core/tracepoints.h"
 #include "ui/widgets/buttons.h"
 #include "ui/widgets/popup_menu.h"
 #include "ui/widgets/scroll_area.h"
@@ -954,6 +955,55 @@ Ui::VideoUserpic *InnerWidget::validateVideoUserpic(
 	)).first->second.get();
 }
 
+void InnerWidget::pruneOffscreenVideoUserpics() {
+	if (_videoUserpics.empty() || _visibleBottom <= _visibleTop) {
+		return;
+	}
+	// A video userpic keeps its decoder looping even when the row has
+	// been scrolled away, so drop the ones that left the viewport (with
+	// a one-screen margin) - painting recreates them when the row comes
+	// back and the loop restarts from the cached bytes.
+	const auto margin = _visibleBottom - _visibleTop;
+	const auto from = _visibleTop - margin;
+	const auto till = _visibleBottom + margin;
+	const auto wasCount = _videoUserpics.size();
+	for (auto i = begin(_videoUserpics); i != end(_videoUserpics);) {
+		const auto history = i->first->owner().historyLoaded(i->first);
+		const auto visible = [&] {
+			if (!history) {
+				return false;
+			} else if (state() == WidgetState::Default) {
+				const auto row = _shownList->getRow(Key(history));
+				if (!row) {
+					return false;
+				}
+				const auto top = defaultRowTop(row);
+				return (top < till) && (top + row->height() > from);
+			}
+			const auto j = ranges::find(
+				_filterResults,
+				Key(history),
+				&FilterResult::key);
+			if (j == end(_filterResults)) {
+				return false;
+			}
+			const auto top = filteredOffset()
+				+ int(j - begin(_filterResults)) * _st->height;
+			return (top < till) && (top + _st->height > from);
+		}();
+		if (visible) {
+			++i;
+		} else {
+			i = _videoUserpics.erase(i);
+		}
+	}
+	if (_videoUserpics.size() != wasCount) {
+		DEBUG_LOG(("Dialogs Info: Video userpic decoders: %1 -> %2."
+			).arg(wasCount
+			).arg(_videoUserpics.size()));
+	}
+}
+
 void InnerWidget::paintCollapsedRows(Painter &p, QRect clip) const {
 	auto index = 0;
 	const auto rowHeight = st::dialogsImportantBarHeight;
@@ -2647,6 +2697,7 @@ void InnerWidget::visibleTopBottomUpdated(
 	_visibleTop = visibleTop;
 	_visibleBottom = visibleBottom;
 	preloadRowsData();
+	pruneOffscreenVideoUserpics();
 	const auto loadTill = _visibleTop
 		+ PreloadHeightsCount * (_visibleBottom - _visibleTop);
 	if (_state == WidgetState::Filtered && loadTill >= peerSearchOffset()) {
@@ -2842,6 +2893,8 @@ void InnerWidget::editOpenedFilter() {
 }
 
 void InnerWidget::refresh(bool toTop) {
+	TRACE_SCOPE("Dialogs::InnerWidget::refresh");
+
 	if (!_geometryInited) {
 		return;
 	} else if (needCollapsedRowsRefresh()) {
@@ -2871,8 +2924,11 @@ void InnerWidget::refresh(bool toTop) {
 	if (toTop) {
 		stopReorderPinned();
 		jumpToTop();
-		preloadRowsData();
 	}
+	// Kick off the userpic loads for the rows that just appeared right
+	// away instead of waiting for them to be painted once empty - this
+	// hides the pop-in wave while the initial dialogs are arriving.
+	preloadRowsData();
 	_controller->setDialogsListDisplayForced(
 		_searchInChat || !_filter.isEmpty());
 	update();
@@ -3331,7 +3387,10 @@ void InnerWidget::preloadRowsData() {
 	}
 
 	auto yFrom = _visibleTop;
-	auto yTo = _visibleTop + (_visibleBottom - _visibleTop) * (PreloadHeightsCount + 1);
+	const auto visibleHeight = (_visibleBottom > _visibleTop)
+		? (_visibleBottom - _visibleTop)
+		: parentWidget()->height();
+	auto yTo = _visibleTop + visibleHeight * (PreloadHeightsCount + 1);
 	if (_state == WidgetState::Default) {
 		auto otherStart = _shownList->size() * _st->height;
 		if (yFrom < otherStart) {
@@ -3464,7 +3523,7 @@ bool InnerWidget::chooseHashtag() {
 			}
 		}
 		cSetRecentSearchHashtags(recent);
-		session().local().writeRecentHashtagsAndBots();
+		session().local().writeRecentHashtagsAndBotsDelayed();
 		_refreshHashtagsRequests.fire({});
 		selectByMouse(QCursor::pos());
 	} else {
@@ -205,6 +205,27 @@ UnreadState MainList::unreadState() const {
 	return result;
 }
 
+void MainList::scheduleUnreadStateNotify(const UnreadState &wasState) {
+	// Bursts of per-message changes (e.g. while applying a difference
+	// after reconnect) coalesce into one notification per event loop
+	// iteration. Delta-based consumers stay correct: the first pending
+	// wasState is kept, so the (now - was) they compute at flush time
+	// covers the whole batch.
+	if (_unreadNotifyWasState) {
+		return;
+	}
+	_unreadNotifyWasState = wasState;
+	crl::on_main(&_guard, [=] {
+		flushUnreadStateNotify();
+	});
+}
+
+void MainList::flushUnreadStateNotify() {
+	if (auto was = base::take(_unreadNotifyWasState)) {
+		_unreadStateChanges.fire(std::move(*was));
+	}
+}
+
 rpl::producer<UnreadState> MainList::unreadStateChanges() const {
 	return _unreadStateChanges.events();
 }
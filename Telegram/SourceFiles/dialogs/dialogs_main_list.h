@@ -58,6 +58,8 @@ private:
 	void recomputeFullListSize();
 
 	inline auto unreadStateChangeNotifier(bool notify);
+	void scheduleUnreadStateNotify(const UnreadState &wasState);
+	void flushUnreadStateNotify();
 
 	FilterId _filterId = 0;
 	IndexedList _all;
@@ -65,6 +67,8 @@ private:
 	UnreadState _unreadState;
 	UnreadState _cloudUnreadState;
 	rpl::event_stream<UnreadState> _unreadStateChanges;
+	std::optional<UnreadState> _unreadNotifyWasState;
+	base::has_weak_ptr _guard;
 	rpl::variable<int> _fullListSize = 0;
 	int _cloudListSize = 0;
 
@@ -79,7 +83,7 @@ auto MainList::unreadStateChangeNotifier(bool notify) {
 	const auto wasState = notify ? unreadState() : UnreadState();
 	return gsl::finally([=] {
 		if (notify) {
-			_unreadStateChanges.fire_copy(wasState);
+			scheduleUnreadStateNotify(wasState);
 		}
 	});
 }
@@ -90,6 +90,12 @@ namespace {
 constexpr auto kSearchPerPage = 50;
 constexpr auto kStoriesExpandDuration = crl::time(200);
 
+[[nodiscard]] QString SearchCacheKey(const QString &query) {
+	// Server-side message search is case-insensitive, let "Foo" and "foo"
+	// share one cached first page instead of refetching it.
+	return query.toLower();
+}
+
 base::options::toggle OptionForumHideChatsList({
 	.id = kOptionForumHideChatsList,
 	.name = "Hide chats list in forums",
@@ -1735,7 +1741,7 @@ bool Widget::searchMessages(bool searchCache) {
 		if (!success) {
 			return false;
 		}
-		const auto i = _searchCache.find(q);
+		const auto i = _searchCache.find(SearchCacheKey(q));
 		if (i != _searchCache.end()) {
 			_searchQuery = q;
 			_searchQueryFrom = _searchFromAuthor;
@@ -1809,7 +1815,9 @@ bool Widget::searchMessages(bool searchCache) {
 					searchFailed(type, error, _searchRequest);
 					finish();
 				}).send();
-				_searchQueries.emplace(_searchRequest, _searchQuery);
+				_searchQueries.emplace(
+					_searchRequest,
+					SearchCacheKey(_searchQuery));
 				return _searchRequest;
 			});
 		} else {
@@ -1834,7 +1842,9 @@ bool Widget::searchMessages(bool searchCache) {
 			}).fail([=](const MTP::Error &error) {
 				searchFailed(type, error, _searchRequest);
 			}).send();
-			_searchQueries.emplace(_searchRequest, _searchQuery);
+			_searchQueries.emplace(
+				_searchRequest,
+				SearchCacheKey(_searchQuery));
 		}
 	}
 	const auto query = Api::ConvertPeerSearchQuery(q);
@@ -2085,7 +2095,9 @@ void Widget::searchMore() {
 					finish();
 				}).send();
 				if (!_lastSearchId) {
-					_searchQueries.emplace(_searchRequest, _searchQuery);
+					_searchQueries.emplace(
+						_searchRequest,
+						SearchCacheKey(_searchQuery));
 				}
 				return _searchRequest;
 			});
@@ -2116,7 +2128,9 @@ void Widget::searchMore() {
 				searchFailed(type, error, _searchRequest);
 			}).send();
 			if (!_lastSearchId) {
-				_searchQueries.emplace(_searchRequest, _searchQuery);
+				_searchQueries.emplace(
+					_searchRequest,
+					SearchCacheKey(_searchQuery));
 			}
 		}
 	} else if (_searchInMigrated && !_searchFullMigrated) {
@@ -2300,6 +2314,13 @@ void Widget::searchReceived(
 	_inner->searchReceived(messages, inject, type, fullCount);
 
 	_searchRequest = 0;
+	if ((type == SearchRequestType::FromStart
+		|| type == SearchRequestType::PeerFromStart)
+		&& !_searchFull) {
+		// Warm up the second page while the user reads the first one,
+		// so scrolling down doesn't have to wait for the network.
+		searchMore();
+	}
 	listScrollUpdated();
 	update();
 }
@@ -91,9 +91,30 @@ void PaintRowDate(
 	const auto nowDate = now.date();
 	const auto lastDate = lastTime.date();
 
+	// Going through QLocale for every visible row on every paint is
+	// surprisingly expensive, so memoize the formatted texts per day.
+	static auto Cache = base::flat_map<qint64, QString>();
+	static auto CacheDate = QDate();
+	constexpr auto kCacheLimit = 4096;
+	if (CacheDate != nowDate) {
+		CacheDate = nowDate;
+		Cache.clear();
+	}
+	const auto key = lastTime.toSecsSinceEpoch();
+	const auto i = Cache.find(key);
+	if (i != end(Cache)) {
+		PaintRowTopRight(p, i->second, rectForName, context);
+		return;
+	}
+
+	auto cacheable = true;
 	const auto dt = [&] {
-		if ((lastDate == nowDate)
-			|| (qAbs(lastTime.secsTo(now)) < kRecentlyInSeconds)) {
+		if (lastDate == nowDate) {
+			return QLocale().toString(lastTime.time(), QLocale::ShortFormat);
+		} else if (qAbs(lastTime.secsTo(now)) < kRecentlyInSeconds) {
+			// The format switches as this interval runs out,
+			// so such texts can't be cached for the whole day.
+			cacheable = false;
 			return QLocale().toString(lastTime.time(), QLocale::ShortFormat);
 		} else if (qAbs(lastDate.daysTo(nowDate)) < 7) {
 			return langDayOfWeek(lastDate);
@@ -101,6 +122,9 @@ void PaintRowDate(
 			return QLocale().toString(lastDate, QLocale::ShortFormat);
 		}
 	}();
+	if (cacheable && Cache.size() < kCacheLimit) {
+		Cache.emplace(key, dt);
+	}
 	PaintRowTopRight(p, dt, rectForName, context);
 }
 
@@ -39,6 +39,80 @@ constexpr auto kFrictionRatio = 0.15;
 constexpr auto kExpandCatchUpDuration = crl::time(200);
 constexpr auto kMaxTooltipNames = 3;
 
+// Stroking the unread gradient ring is the costly part of painting
+// story heads and the ring looks the same for every head of one size,
+// so render it once and stamp the sprite for each head.
+struct UnreadRingSprite {
+	float64 photo = 0.;
+	float64 line = 0.;
+	float64 radius = 0.;
+	int dpr = 0;
+	QGradientStops stops;
+	QImage image;
+};
+std::vector<UnreadRingSprite> UnreadRingSprites;
+
+constexpr auto kUnreadRingSpritesLimit = 4;
+
+[[nodiscard]] float64 UnreadRingMargin(float64 line) {
+	return std::ceil(line);
+}
+
+[[nodiscard]] const QImage &ValidateUnreadRingSprite(
+		QLinearGradient gradient,
+		float64 photo,
+		float64 line) {
+	const auto radius = Kotato::UserpicRadius();
+	const auto dpr = int(style::DevicePixelRatio());
+	const auto stops = gradient.stops();
+	for (const auto &sprite : UnreadRingSprites) {
+		if (sprite.photo == photo
+			&& sprite.line == line
+			&& sprite.radius == radius
+			&& sprite.dpr == dpr
+			&& sprite.stops == stops) {
+			return sprite.image;
+		}
+	}
+	while (UnreadRingSprites.size() >= kUnreadRingSpritesLimit) {
+		UnreadRingSprites.erase(begin(UnreadRingSprites));
+	}
+	const auto outerAdd = 1.5 * line;
+	const auto margin = UnreadRingMargin(line);
+	const auto side = photo + 2. * (outerAdd + margin);
+	auto image = QImage(
+		QSize(int(std::ceil(side * dpr)), int(std::ceil(side * dpr))),
+		QImage::Format_ARGB32_Premultiplied);
+	image.setDevicePixelRatio(dpr);
+	image.fill(Qt::transparent);
+	{
+		auto q = QPainter(&image);
+		auto hq = PainterHighQualityEnabler(q);
+		const auto userpic = QRectF(
+			margin + outerAdd,
+			margin + outerAdd,
+			photo,
+			photo);
+		gradient.setStart(userpic.topRight());
+		gradient.setFinalStop(userpic.bottomLeft());
+		q.setPen(QPen(gradient, line));
+		q.setBrush(Qt::NoBrush);
+		Kotato::DrawUserpicShape(
+			q,
+			userpic.marginsAdded({ outerAdd, outerAdd, outerAdd, outerAdd }),
+			outerAdd);
+	}
+	UnreadRingSprites.push_back({
+		photo,
+		line,
+		radius,
+		dpr,
+		stops,
+		std::move(image),
+	});
+	return UnreadRingSprites.back().image;
+}
+
 [[nodiscard]] int AvailableNameWidth(const style::DialogsStoriesList &st) {
 	const auto &full = st.full;
 	const auto &font = full.nameStyle.font;
@@ -527,9 +601,10 @@ void List::paint(
 			gradient.setStart(userpic.topRight());
 			gradient.setFinalStop(userpic.bottomLeft());
 			if (!fullUnreadCount) {
-				p.setPen(QPen(gradient, line));
-				p.setBrush(Qt::NoBrush);
-				Kotato::DrawUserpicShape(p, outer, outerAdd);
+				const auto margin = UnreadRingMargin(line);
+				p.drawImage(
+					outer.topLeft() - QPointF(margin, margin),
+					ValidateUnreadRingSprite(gradient, photo, line));
 			} else {
 				validateSegments(itemFull, gradient, line, true);
 				Ui::PaintOutlineSegments(
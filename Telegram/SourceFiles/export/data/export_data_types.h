@@ -75,6 +75,9 @@ struct File {
 	int64 size = 0;
 	QByteArray content;
 
+	// Hex SHA-256 of the written bytes, filled while downloading.
+	QByteArray sha256;
+
 	QString suggestedPath;
 
 	QString relativePath;
@@ -15,6 +15,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/bytes.h"
 #include "base/options.h"
 #include "base/random.h"
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
 #include <set>
 #include <deque>
 
@@ -174,6 +176,8 @@ struct ApiWrap::FileProcess {
 	Data::FileOrigin origin;
 	int64 offset = 0;
 	int64 size = 0;
+	QCryptographicHash contentHash = QCryptographicHash(
+		QCryptographicHash::Sha256);
 
 	struct Request {
 		int64 offset = 0;
@@ -226,6 +230,7 @@ struct ApiWrap::ChatProcess {
 	Data::ParseMediaContext context;
 	std::optional<Data::MessagesSlice> slice;
 	bool lastSlice = false;
+	bool stopped = false;
 	int fileIndex = 0;
 };
 
@@ -1704,6 +1709,11 @@ void ApiWrap::loadMessagesFiles(Data::MessagesSlice &&slice) {
 	Expects(_chatProcess != nullptr);
 	Expects(!_chatProcess->slice.has_value());
 
+	if (_chatProcess->stopped) {
+		// The previous slice failed to be written while this one was
+		// already requested, just drop the response.
+		return;
+	}
 	collectMessagesCustomEmoji(slice);
 
 	if (slice.list.empty()) {
@@ -1895,9 +1905,6 @@ void ApiWrap::finishMessagesSlice() {
 		if (splitIndex < 0) {
 			slice = AdjustMigrateMessageIds(std::move(slice));
 		}
-		if (!_chatProcess->handleSlice(std::move(slice))) {
-			return;
-		}
 	}
 	if (_chatProcess->lastSlice
 		&& (++_chatProcess->localSplitIndex
@@ -1905,10 +1912,24 @@ void ApiWrap::finishMessagesSlice() {
 		_chatProcess->lastSlice = false;
 		_chatProcess->largestIdPlusOne = 1;
 	}
-	if (!_chatProcess->lastSlice) {
+
+	// Request the next slice before writing this one, so the network
+	// round-trip overlaps the formatting and the disk write. The empty
+	// split case is excluded, it delivers the next slice synchronously.
+	const auto prefetched = !_chatProcess->lastSlice
+		&& (_chatProcess->info.messagesCountPerSplit[
+			_chatProcess->localSplitIndex] > 0);
+	if (prefetched) {
 		requestMessagesSlice();
-	} else {
+	}
+	if (!slice.list.empty() && !_chatProcess->handleSlice(std::move(slice))) {
+		_chatProcess->stopped = true;
+		return;
+	}
+	if (_chatProcess->lastSlice) {
 		finishMessages();
+	} else if (!prefetched) {
+		requestMessagesSlice();
 	}
 }
 
@@ -1938,6 +1959,9 @@ void ApiWrap::loadMessageFileDone(const QString &relativePath) {
 	file.relativePath = relativePath;
 	if (relativePath.isEmpty()) {
 		file.skipReason = Data::File::SkipReason::Unavailable;
+	} else if (const auto i = _fileSha256.find(relativePath)
+		; i != end(_fileSha256)) {
+		file.sha256 = i->second;
 	}
 	loadNextMessageFile();
 }
@@ -2057,12 +2081,32 @@ bool ApiWrap::writePreloadedFile(
 
 	if (const auto path = _fileCache->find(file.location)) {
 		file.relativePath = *path;
+		if (const auto i = _fileSha256.find(*path); i != end(_fileSha256)) {
+			file.sha256 = i->second;
+		}
 		return true;
 	} else if (!file.content.isEmpty()) {
+		const auto digest = QCryptographicHash::hash(
+			file.content,
+			QCryptographicHash::Sha256);
+		if (const auto i = _contentCache.find(digest)
+			; i != end(_contentCache)) {
+			file.relativePath = i->second;
+			file.sha256 = digest.toHex();
+			_fileCache->save(file.location, file.relativePath);
+			return true;
+		}
 		const auto process = prepareFileProcess(file, origin);
-		if (const auto result = process->file.writeBlock(file.content)) {
+		auto result = process->file.writeBlock(file.content);
+		if (result) {
+			result = process->file.flush();
+		}
+		if (result) {
 			file.relativePath = process->relativePath;
+			file.sha256 = digest.toHex();
 			_fileCache->save(file.location, file.relativePath);
+			_contentCache.emplace(digest, file.relativePath);
+			_fileSha256.emplace(file.relativePath, file.sha256);
 		} else {
 			ioError(result);
 		}
@@ -2186,6 +2230,7 @@ void ApiWrap::filePartDone(int64 offset, const MTPupload_File &result) {
 		auto &file = _fileProcess->file;
 		while (!requests.empty() && !requests.front().bytes.isEmpty()) {
 			const auto &bytes = requests.front().bytes;
+			_fileProcess->contentHash.addData(bytes);
 			if (const auto result = file.writeBlock(bytes); !result) {
 				ioError(result);
 				return;
@@ -2208,9 +2253,26 @@ void ApiWrap::filePartDone(int64 offset, const MTPupload_File &result) {
 	}
 
 	auto process = base::take(_fileProcess);
-	const auto relativePath = process->relativePath;
-	_fileCache->save(process->location, relativePath);
-	process->done(process->relativePath);
+	if (const auto result = process->file.flush(); !result) {
+		ioError(result);
+		return;
+	}
+	auto done = std::move(process->done);
+	auto relativePath = process->relativePath;
+	const auto location = process->location;
+	const auto digest = process->contentHash.result();
+	process = nullptr;
+	if (const auto i = _contentCache.find(digest); i != end(_contentCache)) {
+		// Identical bytes were already saved for another chat, reference
+		// the first copy instead of keeping a duplicate on disk.
+		QFile::remove(_settings->path + relativePath);
+		relativePath = i->second;
+	} else {
+		_contentCache.emplace(digest, relativePath);
+	}
+	_fileSha256.emplace(relativePath, digest.toHex());
+	_fileCache->save(location, relativePath);
+	done(relativePath);
 }
 
 void ApiWrap::filePartRefreshReference(int64 offset) {
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "export/export_settings.h"
 #include "export/data/export_data_types.h"
 #include "export/output/export_output_abstract.h"
+#include "export/output/export_output_file.h"
 #include "export/output/export_output_result.h"
 #include "export/output/export_output_stats.h"
 #include "mtproto/mtp_instance.h"
@@ -81,6 +82,8 @@ private:
 	void exportOtherData();
 	void exportDialogs();
 	void exportNextDialog();
+	void accumulateDialogStats(const Data::DialogInfo &info);
+	[[nodiscard]] Output::Result writeStatsSummary();
 
 	template <typename Callback = const decltype(kNullStateCallback) &>
 	ProcessingState prepareState(
@@ -110,6 +113,17 @@ private:
 	Data::DialogsInfo _dialogsInfo;
 	int _dialogIndex = -1;
 
+	// Per-chat output totals, accumulated while the writer processes each
+	// dialog and dumped into a summary file when the export finishes.
+	struct DialogTotals {
+		Data::Utf8String name;
+		int files = 0;
+		int64 bytes = 0;
+	};
+	std::vector<DialogTotals> _dialogsTotals;
+	int _dialogStartFiles = 0;
+	int64 _dialogStartBytes = 0;
+
 	int _messagesWritten = 0;
 	int _messagesCount = 0;
 
@@ -340,7 +354,8 @@ void ControllerObject::cancelExportFast() {
 
 void ControllerObject::exportNext() {
 	if (++_stepIndex >= _steps.size()) {
-		if (ioCatchError(_writer->finish())) {
+		if (ioCatchError(_writer->finish())
+			|| ioCatchError(writeStatsSummary())) {
 			return;
 		}
 		_api.finishExport([=] {
@@ -501,6 +516,8 @@ void ControllerObject::exportNextDialog() {
 			if (ioCatchError(_writer->writeDialogStart(info))) {
 				return false;
 			}
+			_dialogStartFiles = _stats.filesCount();
+			_dialogStartBytes = _stats.bytesCount();
 			_messagesWritten = 0;
 			_messagesCount = ranges::accumulate(
 				info.messagesCountPerSplit,
@@ -521,6 +538,7 @@ void ControllerObject::exportNextDialog() {
 			if (ioCatchError(_writer->writeDialogEnd())) {
 				return;
 			}
+			accumulateDialogStats(*info);
 			exportNextDialog();
 		});
 		return;
@@ -531,6 +549,52 @@ void ControllerObject::exportNextDialog() {
 	exportNext();
 }
 
+void ControllerObject::accumulateDialogStats(const Data::DialogInfo &info) {
+	auto name = info.name;
+	if (!info.lastName.isEmpty()) {
+		name += ' ';
+		name += info.lastName;
+	}
+	_dialogsTotals.push_back({
+		name.isEmpty() ? Data::Utf8String("Deleted Account") : name,
+		_stats.filesCount() - _dialogStartFiles,
+		_stats.bytesCount() - _dialogStartBytes,
+	});
+}
+
+Output::Result ControllerObject::writeStatsSummary() {
+	if (_dialogsTotals.empty()) {
+		return Output::Result::Success();
+	}
+	auto block = QByteArray();
+	block.append("Files and bytes written per chat.\n\n");
+	auto totalFiles = 0;
+	auto totalBytes = int64(0);
+	for (const auto &entry : _dialogsTotals) {
+		totalFiles += entry.files;
+		totalBytes += entry.bytes;
+		block.append(entry.name);
+		block.append(": ");
+		block.append(Data::NumberToString(entry.files));
+		block.append(" files, ");
+		block.append(Data::FormatFileSize(entry.bytes));
+		block.append('\n');
+	}
+	block.append("\nTotal: ");
+	block.append(Data::NumberToString(totalFiles));
+	block.append(" files, ");
+	block.append(Data::FormatFileSize(totalBytes));
+	block.append('\n');
+
+	auto file = Output::File(
+		_settings.path + u"export_summary.txt"_q,
+		&_stats);
+	if (const auto result = file.writeBlock(block); !result) {
+		return result;
+	}
+	return file.flush();
+}
+
 template <typename Callback>
 ProcessingState ControllerObject::prepareState(
 		Step step,
@@ -18,10 +18,19 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace Export {
 namespace Output {
+namespace {
+
+constexpr auto kFlushThreshold = 256 * 1024;
+
+} // namespace
 
 File::File(const QString &path, Stats *stats) : _path(path), _stats(stats) {
 }
 
+File::~File() {
+	(void)flush();
+}
+
 int64 File::size() const {
 	return _offset;
 }
@@ -43,18 +52,39 @@ Result File::writeBlockAttempt(const QByteArray &block) {
 		_inStats = true;
 		_stats->incrementFiles();
 	}
-	if (const auto result = reopen(); !result) {
-		return result;
-	}
 	const auto size = block.size();
 	if (!size) {
 		return Result::Success();
 	}
-	if (_file->write(block) == size && _file->flush()) {
-		_offset += size;
-		if (_stats) {
-			_stats->incrementBytes(size);
-		}
+	_buffer.append(block);
+	_offset += size;
+	if (_stats) {
+		_stats->incrementBytes(size);
+	}
+	return (_buffer.size() >= kFlushThreshold)
+		? flushAttempt()
+		: Result::Success();
+}
+
+Result File::flush() {
+	const auto result = flushAttempt();
+	if (!result) {
+		_file.reset();
+	}
+	return result;
+}
+
+Result File::flushAttempt() {
+	if (_buffer.isEmpty()) {
+		return Result::Success();
+	}
+	if (const auto result = reopen(); !result) {
+		return result;
+	}
+	const auto size = _buffer.size();
+	if (_file->write(_buffer) == size && _file->flush()) {
+		_flushedOffset += size;
+		_buffer.clear();
 		return Result::Success();
 	}
 	return error();
@@ -66,12 +96,12 @@ Result File::reopen() {
 	}
 	_file.emplace(_path);
 	if (_file->exists()) {
-		if (_file->size() < _offset) {
+		if (_file->size() < _flushedOffset) {
 			return fatalError();
-		} else if (!_file->resize(_offset)) {
+		} else if (!_file->resize(_flushedOffset)) {
 			return error();
 		}
-	} else if (_offset > 0) {
+	} else if (_flushedOffset > 0) {
 		return fatalError();
 	}
 	if (_file->open(QIODevice::Append)) {
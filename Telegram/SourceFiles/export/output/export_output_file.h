@@ -22,11 +22,17 @@ class Stats;
 class File {
 public:
 	File(const QString &path, Stats *stats);
+	~File();
 
 	[[nodiscard]] int64 size() const;
 	[[nodiscard]] bool empty() const;
 
+	// Blocks are gathered in memory and written out in large chunks,
+	// so millions of small writeBlock calls don't each hit the disk.
+	// Call flush() when the logical file is complete, the destructor
+	// only does a best-effort flush and can't report an error.
 	[[nodiscard]] Result writeBlock(const QByteArray &block);
+	[[nodiscard]] Result flush();
 
 	[[nodiscard]] static QString PrepareRelativePath(
 		const QString &folder,
@@ -40,12 +46,15 @@ public:
 private:
 	[[nodiscard]] Result reopen();
 	[[nodiscard]] Result writeBlockAttempt(const QByteArray &block);
+	[[nodiscard]] Result flushAttempt();
 
 	[[nodiscard]] Result error() const;
 	[[nodiscard]] Result fatalError() const;
 
 	QString _path;
+	QByteArray _buffer;
 	int64 _offset = 0;
+	int64 _flushedOffset = 0;
 	std::optional<QFile> _file;
 
 	Stats *_stats = nullptr;
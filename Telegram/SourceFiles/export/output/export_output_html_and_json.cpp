@@ -11,11 +11,63 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "export/output/export_output_json.h"
 #include "export/output/export_output_result.h"
 
+#include <crl/crl_semaphore.h>
+#include <QtCore/QMutex>
+
 namespace Export::Output {
 
-HtmlAndJsonWriter::HtmlAndJsonWriter() {
-	_writers.push_back(CreateWriter(Format::Html));
-	_writers.push_back(CreateWriter(Format::Json));
+struct HtmlAndJsonWriter::LaneError {
+	[[nodiscard]] std::optional<Result> get() const {
+		if (!failed.load(std::memory_order_acquire)) {
+			return std::nullopt;
+		}
+		QMutexLocker lock(&mutex);
+		return value;
+	}
+
+	void set(const Result &result) {
+		QMutexLocker lock(&mutex);
+		value = result;
+		failed.store(true, std::memory_order_release);
+	}
+
+	mutable QMutex mutex;
+	std::optional<Result> value;
+	std::atomic<bool> failed = false;
+
+};
+
+class HtmlAndJsonWriter::JsonLane final {
+public:
+	JsonLane(
+		crl::weak_on_queue<JsonLane> weak,
+		std::shared_ptr<LaneError> error)
+	: _writer(CreateWriter(Format::Json))
+	, _error(std::move(error)) {
+	}
+
+	template <typename Method, typename ...Args>
+	void run(Method method, Args &&...args) {
+		if (_error->failed.load(std::memory_order_acquire)) {
+			return;
+		}
+		const auto result = ((*_writer).*method)(
+			std::forward<Args>(args)...);
+		if (!result) {
+			_error->set(result);
+		}
+	}
+
+private:
+	const std::unique_ptr<AbstractWriter> _writer;
+	const std::shared_ptr<LaneError> _error;
+
+};
+
+HtmlAndJsonWriter::HtmlAndJsonWriter()
+: _jsonError(std::make_shared<LaneError>())
+, _html(CreateWriter(Format::Html))
+, _json(_jsonError) {
 }
 
 Format HtmlAndJsonWriter::format() {
@@ -26,123 +78,104 @@ Result HtmlAndJsonWriter::start(
 		const Settings &settings,
 		const Environment &environment,
 		Stats *stats) {
-	return invoke([&](WriterPtr w) {
-		return w->start(settings, environment, stats);
-	});
+	return invoke(&AbstractWriter::start, settings, environment, stats);
 }
 
 Result HtmlAndJsonWriter::writePersonal(const Data::PersonalInfo &data) {
-	return invoke([&](WriterPtr w) {
-		return w->writePersonal(data);
-	});
+	return invoke(&AbstractWriter::writePersonal, data);
 }
 
 Result HtmlAndJsonWriter::writeUserpicsStart(const Data::UserpicsInfo &data) {
-	return invoke([&](WriterPtr w) {
-		return w->writeUserpicsStart(data);
-	});
+	return invoke(&AbstractWriter::writeUserpicsStart, data);
 }
 
 Result HtmlAndJsonWriter::writeUserpicsSlice(const Data::UserpicsSlice &d) {
-	return invoke([&](WriterPtr w) {
-		return w->writeUserpicsSlice(d);
-	});
+	return invoke(&AbstractWriter::writeUserpicsSlice, d);
 }
 
 Result HtmlAndJsonWriter::writeUserpicsEnd() {
-	return invoke([&](WriterPtr w) {
-		return w->writeUserpicsEnd();
-	});
+	return invoke(&AbstractWriter::writeUserpicsEnd);
 }
 
 Result HtmlAndJsonWriter::writeStoriesStart(const Data::StoriesInfo &data) {
-	return invoke([&](WriterPtr w) {
-		return w->writeStoriesStart(data);
-	});
+	return invoke(&AbstractWriter::writeStoriesStart, data);
 }
 
 Result HtmlAndJsonWriter::writeStoriesSlice(const Data::StoriesSlice &data) {
-	return invoke([&](WriterPtr w) {
-		return w->writeStoriesSlice(data);
-	});
+	return invoke(&AbstractWriter::writeStoriesSlice, data);
 }
 
 Result HtmlAndJsonWriter::writeStoriesEnd() {
-	return invoke([&](WriterPtr w) {
-		return w->writeStoriesEnd();
-	});
+	return invoke(&AbstractWriter::writeStoriesEnd);
 }
 
 Result HtmlAndJsonWriter::writeContactsList(const Data::ContactsList &data) {
-	return invoke([&](WriterPtr w) {
-		return w->writeContactsList(data);
-	});
+	return invoke(&AbstractWriter::writeContactsList, data);
 }
 
 Result HtmlAndJsonWriter::writeSessionsList(const Data::SessionsList &data) {
-	return invoke([&](WriterPtr w) {
-		return w->writeSessionsList(data);
-	});
+	return invoke(&AbstractWriter::writeSessionsList, data);
 }
 
 Result HtmlAndJsonWriter::writeOtherData(const Data::File &data) {
-	return invoke([&](WriterPtr w) {
-		return w->writeOtherData(data);
-	});
+	return invoke(&AbstractWriter::writeOtherData, data);
 }
 
 Result HtmlAndJsonWriter::writeDialogsStart(const Data::DialogsInfo &data) {
-	return invoke([&](WriterPtr w) {
-		return w->writeDialogsStart(data);
-	});
+	return invoke(&AbstractWriter::writeDialogsStart, data);
 }
 
 Result HtmlAndJsonWriter::writeDialogStart(const Data::DialogInfo &data) {
-	return invoke([&](WriterPtr w) {
-		return w->writeDialogStart(data);
-	});
+	return invoke(&AbstractWriter::writeDialogStart, data);
 }
 
 Result HtmlAndJsonWriter::writeDialogSlice(const Data::MessagesSlice &data) {
-	return invoke([&](WriterPtr w) {
-		return w->writeDialogSlice(data);
-	});
+	return invoke(&AbstractWriter::writeDialogSlice, data);
 }
 
 Result HtmlAndJsonWriter::writeDialogEnd() {
-	return invoke([&](WriterPtr w) {
-		return w->writeDialogEnd();
-	});
+	return invoke(&AbstractWriter::writeDialogEnd);
 }
 
 Result HtmlAndJsonWriter::writeDialogsEnd() {
-	return invoke([&](WriterPtr w) {
-		return w->writeDialogsEnd();
-	});
+	return invoke(&AbstractWriter::writeDialogsEnd);
 }
 
 Result HtmlAndJsonWriter::finish() {
-	return invoke([&](WriterPtr w) {
-		return w->finish();
-	});
+	const auto html = invoke(&AbstractWriter::finish);
+	const auto json = joinJsonLane();
+	return html ? json : html;
 }
 
 QString HtmlAndJsonWriter::mainFilePath() {
-	return _writers.front()->mainFilePath();
+	return _html->mainFilePath();
 }
 
 HtmlAndJsonWriter::~HtmlAndJsonWriter() = default;
 
-Result HtmlAndJsonWriter::invoke(Fn<Result(WriterPtr)> method) const {
-	auto result = Result(Result::Type::Success, QString());
-	for (const auto &writer : _writers) {
-		const auto current = method(writer);
-		if (!current) {
-			result = current;
-		}
+template <typename Method, typename ...Args>
+Result HtmlAndJsonWriter::invoke(Method method, const Args &...args) {
+	if (const auto error = _jsonError->get()) {
+		return *error;
+	}
+	_json.with([=](JsonLane &lane) {
+		lane.run(method, args...);
+	});
+	return ((*_html).*method)(args...);
+}
+
+Result HtmlAndJsonWriter::joinJsonLane() {
+	// The lane keeps its own order, so waking up after the last posted
+	// task means every queued record has been written out already.
+	auto semaphore = crl::semaphore();
+	_json.with([&](JsonLane &lane) {
+		semaphore.release();
+	});
+	semaphore.acquire();
+	if (const auto error = _jsonError->get()) {
+		return *error;
 	}
-	return result;
+	return Result::Success();
 }
 
 } // namespace Export::Output
-
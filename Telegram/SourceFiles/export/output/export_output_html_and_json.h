@@ -9,6 +9,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include "export/output/export_output_abstract.h"
 
+#include <crl/crl_object_on_queue.h>
+
 namespace Export::Output {
 
 class HtmlWriter;
@@ -55,10 +57,18 @@ public:
 	~HtmlAndJsonWriter();
 
 private:
-	using WriterPtr = const std::unique_ptr<AbstractWriter> &;
-	Result invoke(Fn<Result(WriterPtr)> method) const;
-
-	std::vector<std::unique_ptr<AbstractWriter>> _writers;
+	class JsonLane;
+	struct LaneError;
+
+	// Runs the method on the html writer right here and posts a copy of
+	// the arguments to the json lane, so both formats render in parallel.
+	template <typename Method, typename ...Args>
+	[[nodiscard]] Result invoke(Method method, const Args &...args);
+	[[nodiscard]] Result joinJsonLane();
+
+	const std::shared_ptr<LaneError> _jsonError;
+	std::unique_ptr<AbstractWriter> _html;
+	crl::object_on_queue<JsonLane> _json;
 
 };
 
@@ -653,6 +653,20 @@ QByteArray SerializeMessage(
 		pushTTL();
 	}, [&](const Document &data) {
 		pushPath(data.file, "file");
+		if (data.id
+			&& data.file.location.dcId
+			&& data.file.skipReason == SkipReason::None
+			&& !data.file.relativePath.isEmpty()) {
+			// Enough identity to verify the file and register it back
+			// into a fresh install when importing the archive. The id
+			// is a string, uint64 doesn't survive a double round-trip.
+			push("file_document_id", Data::NumberToString(data.id));
+			push("file_dc_id", data.file.location.dcId);
+			push("file_size", data.file.size);
+			if (!data.file.sha256.isEmpty()) {
+				push("file_sha256", data.file.sha256);
+			}
+		}
 		if (data.thumb.width > 0) {
 			pushPath(data.thumb.file, "thumbnail");
 		}
@@ -1414,11 +1428,14 @@ Result JsonWriter::finish() {
 
 	if (_settings.onlySinglePeer()) {
 		Assert(_context.nesting.empty());
-		return Result::Success();
+		return _output->flush();
 	}
 	auto block = popNesting();
 	Assert(_context.nesting.empty());
-	return _output->writeBlock(block);
+	if (const auto result = _output->writeBlock(block); !result) {
+		return result;
+	}
+	return _output->flush();
 }
 
 QString JsonWriter::mainFilePath() {
@@ -18,6 +18,11 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include <QImage>
 
+#ifdef Q_OS_LINUX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // Q_OS_LINUX
+
 #ifdef LIB_FFMPEG_USE_QT_PRIVATE_API
 #include <private/qdrawhelper_p.h>
 #endif // LIB_FFMPEG_USE_QT_PRIVATE_API
@@ -231,15 +236,19 @@ IOPointer MakeIOPointer(
 		void *opaque,
 		int(*read)(void *opaque, uint8_t *buffer, int bufferSize),
 		int(*write)(void *opaque, uint8_t *buffer, int bufferSize),
-		int64_t(*seek)(void *opaque, int64_t offset, int whence)) {
-	auto buffer = reinterpret_cast<uchar*>(av_malloc(kAvioBlockSize));
+		int64_t(*seek)(void *opaque, int64_t offset, int whence),
+		int bufferSize) {
+	if (bufferSize <= 0) {
+		bufferSize = kAvioBlockSize;
+	}
+	auto buffer = reinterpret_cast<uchar*>(av_malloc(bufferSize));
 	if (!buffer) {
 		LogError(u"av_malloc"_q);
 		return {};
 	}
 	auto result = IOPointer(avio_alloc_context(
 		buffer,
-		kAvioBlockSize,
+		bufferSize,
 		write ? 1 : 0,
 		opaque,
 		read,
@@ -264,8 +273,9 @@ FormatPointer MakeFormatPointer(
 		void *opaque,
 		int(*read)(void *opaque, uint8_t *buffer, int bufferSize),
 		int(*write)(void *opaque, uint8_t *buffer, int bufferSize),
-		int64_t(*seek)(void *opaque, int64_t offset, int whence)) {
-	auto io = MakeIOPointer(opaque, read, write, seek);
+		int64_t(*seek)(void *opaque, int64_t offset, int whence),
+		int bufferSize) {
+	auto io = MakeIOPointer(opaque, read, write, seek, bufferSize);
 	if (!io) {
 		return {};
 	}
@@ -330,6 +340,9 @@ CodecPointer MakeCodecPointer(CodecDescriptor descriptor) {
 	}
 	context->pkt_timebase = stream->time_base;
 	if(::Kotato::JsonSettings::GetBool("ffmpeg_multithread")) {
+		// Prefer whole-frame parallelism, slice threading only helps
+		// codecs that cannot thread across frames.
+		context->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
 		if (::Kotato::JsonSettings::GetInt("ffmpeg_thread_count") > 0) {
 			av_opt_set(context, "threads", std::to_string(::Kotato::JsonSettings::GetInt("ffmpeg_thread_count")).c_str(), 0);
 		} else {
@@ -422,7 +435,7 @@ SwscalePointer MakeSwscalePointer(
 		dstSize.width(),
 		dstSize.height(),
 		AVPixelFormat(dstFormat),
-		0,
+		SWS_FAST_BILINEAR, // Presentation scaling, speed over precision.
 		nullptr,
 		nullptr,
 		nullptr);
@@ -563,6 +576,23 @@ QImage CreateFrameStorage(QSize size) {
 	const auto alignedBuffer = buffer + ((address % kAlignImageBy)
 		? (kAlignImageBy - (address % kAlignImageBy))
 		: 0);
+#if defined Q_OS_LINUX && defined MADV_HUGEPAGE
+	// Full-size frames span several megabytes, ask the kernel to back
+	// them with transparent huge pages to cut down the TLB pressure.
+	constexpr auto kHugePageSize = uintptr_t(2 * 1024 * 1024);
+	const auto length = uintptr_t(perLine) * height + kAlignImageBy;
+	if (length >= kHugePageSize) {
+		const auto pageSize = uintptr_t(sysconf(_SC_PAGESIZE));
+		const auto from = (address + pageSize - 1) & ~(pageSize - 1);
+		const auto till = (address + length) & ~(pageSize - 1);
+		if (till > from) {
+			madvise(
+				reinterpret_cast<void*>(from),
+				till - from,
+				MADV_HUGEPAGE);
+		}
+	}
+#endif // Q_OS_LINUX && MADV_HUGEPAGE
 	return QImage(
 		alignedBuffer,
 		width,
@@ -113,7 +113,8 @@ using IOPointer = std::unique_ptr<AVIOContext, IODeleter>;
 	void *opaque,
 	int(*read)(void *opaque, uint8_t *buffer, int bufferSize),
 	int(*write)(void *opaque, uint8_t *buffer, int bufferSize),
-	int64_t(*seek)(void *opaque, int64_t offset, int whence));
+	int64_t(*seek)(void *opaque, int64_t offset, int whence),
+	int bufferSize = 0); // Default kAvioBlockSize.
 
 struct FormatDeleter {
 	void operator()(AVFormatContext *value);
@@ -123,7 +124,8 @@ using FormatPointer = std::unique_ptr<AVFormatContext, FormatDeleter>;
 	void *opaque,
 	int(*read)(void *opaque, uint8_t *buffer, int bufferSize),
 	int(*write)(void *opaque, uint8_t *buffer, int bufferSize),
-	int64_t(*seek)(void *opaque, int64_t offset, int whence));
+	int64_t(*seek)(void *opaque, int64_t offset, int whence),
+	int bufferSize = 0); // Default kAvioBlockSize.
 
 struct CodecDeleter {
 	void operator()(AVCodecContext *value);
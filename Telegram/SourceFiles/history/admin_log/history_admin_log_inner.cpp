@@ -74,6 +74,7 @@ constexpr auto kScrollDateHideTimeout = 1000;
 constexpr auto kEventsFirstPage = 20;
 constexpr auto kEventsPerPage = 50;
 constexpr auto kClearUserpicsAfter = 50;
+constexpr auto kUnloadHeavyPartsPages = 2;
 
 } // namespace
 
@@ -354,6 +355,14 @@ void InnerWidget::visibleTopBottomUpdated(
 		_userpicsCache = std::move(_userpics);
 	}
 
+	// Unload lottie animations and similar heavy parts of the events
+	// scrolled far away, a long audited log materializes a lot of them.
+	const auto pages = kUnloadHeavyPartsPages;
+	const auto visibleAreaHeight = visibleBottom - visibleTop;
+	const auto from = _visibleTop - pages * visibleAreaHeight;
+	const auto till = _visibleBottom + pages * visibleAreaHeight;
+	session().data().unloadHeavyViewParts(this, from, till);
+
 	updateVisibleTopItem();
 	checkPreloadMore();
 	if (scrolledUp) {
@@ -727,9 +727,7 @@ void History::clearUnreadMentionsFor(MsgId topicRootId) {
 			}
 		}
 	}
-	for (const auto &id : items) {
-		unreadMentions().erase(id);
-	}
+	unreadMentions().eraseMany(items);
 }
 
 void History::clearUnreadReactionsFor(MsgId topicRootId) {
@@ -760,9 +758,7 @@ void History::clearUnreadReactionsFor(MsgId topicRootId) {
 			}
 		}
 	}
-	for (const auto &id : items) {
-		unreadReactions().erase(id);
-	}
+	unreadReactions().eraseMany(items);
 }
 
 not_null<HistoryItem*> History::addNewToBack(
@@ -3245,6 +3241,28 @@ auto History::findFirstNonEmpty() const -> Element* {
 	return nullptr;
 }
 
+MsgId History::findMessageIdAfterDate(TimeId date) const {
+	if (blocks.empty()) {
+		return MsgId();
+	} else if (blocks.front()->messages.front()->data()->date() >= date
+		&& !loadedAtTop()) {
+		// The boundary may lie before the loaded range, can't be sure.
+		return MsgId();
+	}
+	for (const auto &block : blocks) {
+		if (block->messages.back()->data()->date() < date) {
+			continue;
+		}
+		for (const auto &element : block->messages) {
+			const auto item = element->data();
+			if (item->date() >= date && item->isRegular()) {
+				return item->id;
+			}
+		}
+	}
+	return MsgId();
+}
+
 auto History::findFirstDisplayed() const -> Element* {
 	for (const auto &block : blocks) {
 		for (const auto &element : block->messages) {
@@ -3492,6 +3510,13 @@ HistoryBlock::HistoryBlock(not_null<History*> history)
 }
 
 int HistoryBlock::resizeGetHeight(int newWidth, ResizeRequest request) {
+	if (request == ResizeRequest::ResizePending && !_pendingResize) {
+		// No message in this block changed since the last walk, so the
+		// accumulated height and the block-relative Y positions are
+		// still valid - expanding one message in a huge chat then costs
+		// one block walk instead of one walk over the whole history.
+		return _height;
+	}
 	auto y = 0;
 	if (request == ResizeRequest::ReinitAll) {
 		for (const auto &message : messages) {
@@ -3512,6 +3537,7 @@ int HistoryBlock::resizeGetHeight(int newWidth, ResizeRequest request) {
 				: message->height();
 		}
 	}
+	_pendingResize = false;
 	_height = y;
 	return _height;
 }
@@ -3519,6 +3545,7 @@ int HistoryBlock::resizeGetHeight(int newWidth, ResizeRequest request) {
 void HistoryBlock::remove(not_null<Element*> view) {
 	Expects(view->block() == this);
 
+	setPendingResize();
 	_history->mainViewRemoved(this, view);
 
 	const auto blockIndex = indexInHistory();
@@ -120,6 +120,10 @@ public:
 	Element *findFirstNonEmpty() const;
 	Element *findFirstDisplayed() const;
 	Element *findLastNonEmpty() const;
+
+	// First regular message with date() >= date, if the loaded range
+	// is enough to prove it is really the first one.
+	[[nodiscard]] MsgId findMessageIdAfterDate(TimeId date) const;
 	Element *findLastDisplayed() const;
 	bool hasOrphanMediaGroupPart() const;
 	[[nodiscard]] std::vector<MsgId> collectMessagesFromParticipantToDelete(
@@ -663,6 +667,9 @@ public:
 	int height() const {
 		return _height;
 	}
+	void setPendingResize() {
+		_pendingResize = true;
+	}
 	not_null<History*> history() const {
 		return _history;
 	}
@@ -698,5 +705,6 @@ protected:
 	int _y = 0;
 	int _height = 0;
 	int _indexInHistory = -1;
+	bool _pendingResize = true;
 
 };
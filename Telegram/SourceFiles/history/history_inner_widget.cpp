@@ -67,6 +67,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "main/main_session_settings.h"
 #include "menu/menu_item_download_files.h"
 #include "core/application.h"
+#include "core/tracepoints.h"
 #include "apiwrap.h"
 #include "api/api_attached_stickers.h"
 #include "api/api_toggling_media.h"
@@ -75,6 +76,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "lang/lang_keys.h"
 #include "data/data_session.h"
 #include "data/data_document.h"
+#include "data/data_document_media.h"
 #include "data/data_channel.h"
 #include "data/data_forum_topic.h"
 #include "data/data_photo_media.h"
@@ -98,6 +100,8 @@ namespace {
 constexpr auto kScrollDateHideTimeout = 1000;
 constexpr auto kUnloadHeavyPartsPages = 2;
 constexpr auto kClearUserpicsAfter = 50;
+constexpr auto kMediaPreloadVelocityMin = 0.2; // Pixels per millisecond.
+constexpr auto kMediaPreloadKeepMax = 64;
 
 // Helper binary search for an item in a list that is not completely
 // above the given top of the visible area or below the given bottom of the visible area
@@ -900,6 +904,8 @@ Ui::ChatPaintContext HistoryInner::preparePaintContext(
 }
 
 void HistoryInner::paintEvent(QPaintEvent *e) {
+	TRACE_SCOPE("HistoryInner::paintEvent");
+
 	if (_controller->contentOverlapped(this, e)
 		|| hasPendingResizedItems()) {
 		return;
@@ -3074,6 +3080,7 @@ bool HistoryInner::wasSelectedText() const {
 
 void HistoryInner::visibleAreaUpdated(int top, int bottom) {
 	auto scrolledUp = (top < _visibleAreaTop);
+	const auto scrollDelta = top - _visibleAreaTop;
 	_visibleAreaTop = top;
 	_visibleAreaBottom = bottom;
 	const auto visibleAreaHeight = bottom - top;
@@ -3132,6 +3139,104 @@ void HistoryInner::visibleAreaUpdated(int top, int bottom) {
 	_emojiInteractions->visibleAreaUpdated(
 		_visibleAreaTop,
 		_visibleAreaBottom);
+
+	checkMediaPreload(scrollDelta);
+}
+
+void HistoryInner::checkMediaPreload(int scrollDelta) {
+	const auto screens = ::Kotato::JsonSettings::GetInt(
+		"media_preload_screens");
+	if (!screens || !scrollDelta) {
+		return;
+	}
+	const auto direction = (scrollDelta > 0) ? 1 : -1;
+	if (direction != _mediaPreloadDirection) {
+		// Direction reversed: let go of the speculative references,
+		// so the unused media can be unloaded, and measure anew.
+		_mediaPreloadDirection = direction;
+		_mediaPreloadVelocity = 0.;
+		_mediaPreloadPhotos.clear();
+		_mediaPreloadDocuments.clear();
+		return;
+	}
+	const auto now = crl::now();
+	const auto elapsed = now - _mediaPreloadTime;
+	_mediaPreloadTime = now;
+	if (elapsed <= 0 || elapsed > crl::time(1000)) {
+		return;
+	}
+	const auto velocity = float64(std::abs(scrollDelta)) / elapsed;
+	_mediaPreloadVelocity = (_mediaPreloadVelocity + velocity) / 2.;
+	if (_mediaPreloadVelocity < kMediaPreloadVelocityMin) {
+		return;
+	}
+	const auto lookahead = screens * (_visibleAreaBottom - _visibleAreaTop);
+	if (direction > 0) {
+		preloadMediaIn(_visibleAreaBottom, _visibleAreaBottom + lookahead);
+	} else {
+		preloadMediaIn(_visibleAreaTop - lookahead, _visibleAreaTop);
+	}
+	while (_mediaPreloadPhotos.size() > kMediaPreloadKeepMax) {
+		_mediaPreloadPhotos.erase(_mediaPreloadPhotos.begin());
+	}
+	while (_mediaPreloadDocuments.size() > kMediaPreloadKeepMax) {
+		_mediaPreloadDocuments.erase(_mediaPreloadDocuments.begin());
+	}
+}
+
+void HistoryInner::preloadMediaIn(int from, int till) {
+	const auto request = [&](History *history, int historytop) {
+		if (!history || historytop < 0 || history->isEmpty()) {
+			return;
+		}
+		const auto top = std::max(from - historytop, 0);
+		const auto bottom = std::min(till - historytop, history->height());
+		if (top >= bottom) {
+			return;
+		}
+		const auto first = BinarySearchBlocksOrItems<true>(
+			history->blocks,
+			top);
+		for (auto i = first; i != int(history->blocks.size()); ++i) {
+			const auto block = history->blocks[i].get();
+			const auto blocktop = block->y();
+			if (blocktop >= bottom) {
+				return;
+			}
+			auto itemIndex = (i == first)
+				? BinarySearchBlocksOrItems<true>(
+					block->messages,
+					top - blocktop)
+				: 0;
+			for (; itemIndex != int(block->messages.size()); ++itemIndex) {
+				const auto view = block->messages[itemIndex].get();
+				const auto itemtop = blocktop + view->y();
+				if (itemtop >= bottom) {
+					return;
+				} else if (itemtop + view->height() <= top) {
+					continue;
+				}
+				const auto item = view->data();
+				const auto media = item->media();
+				if (!media) {
+					continue;
+				}
+				if (const auto photo = media->photo()) {
+					auto photoMedia = photo->createMediaView();
+					photoMedia->automaticLoad(item->fullId(), item);
+					_mediaPreloadPhotos.push_back(std::move(photoMedia));
+				} else if (const auto document = media->document()) {
+					auto documentMedia = document->createMediaView();
+					documentMedia->automaticLoad(item->fullId(), item);
+					documentMedia->thumbnailWanted(item->fullId());
+					_mediaPreloadDocuments.push_back(
+						std::move(documentMedia));
+				}
+			}
+		}
+	};
+	request(_migrated, migratedTop());
+	request(_history, historyTop());
 }
 
 bool HistoryInner::displayScrollDate() const {
@@ -22,6 +22,8 @@ struct ClickHandlerContext;
 
 namespace Data {
 struct Group;
+class PhotoMedia;
+class DocumentMedia;
 } // namespace Data
 
 namespace HistoryView {
@@ -300,6 +302,8 @@ private:
 
 	void scrollDateCheck();
 	void scrollDateHideByTimer();
+	void checkMediaPreload(int scrollDelta);
+	void preloadMediaIn(int from, int till);
 	bool canHaveFromUserpics() const;
 	void mouseActionStart(const QPoint &screenPos, Qt::MouseButton button);
 	void mouseActionUpdate();
@@ -534,4 +538,11 @@ private:
 	int _scrollDateLastItemTop = 0;
 	ClickHandlerPtr _scrollDateLink;
 
+	// Speculative media preload ahead of fast scrolling.
+	int _mediaPreloadDirection = 0; // Negative means scrolling up.
+	float64 _mediaPreloadVelocity = 0.; // Pixels per millisecond.
+	crl::time _mediaPreloadTime = 0;
+	std::vector<std::shared_ptr<Data::PhotoMedia>> _mediaPreloadPhotos;
+	std::vector<std::shared_ptr<Data::DocumentMedia>> _mediaPreloadDocuments;
+
 };
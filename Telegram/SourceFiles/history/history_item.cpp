@@ -47,6 +47,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_saved_sublist.h"
 #include "data/data_scheduled_messages.h"
 #include "data/data_changes.h"
+#include "data/data_search_index.h"
 #include "data/data_session.h"
 #include "data/data_message_reactions.h"
 #include "data/data_folder.h"
@@ -71,9 +72,55 @@ namespace {
 
 constexpr auto kNotificationTextLimit = 255;
 constexpr auto kPinnedMessageTextLimit = 16;
+constexpr auto kPoolSlabSize = 128;
 
 using ItemPreview = HistoryView::ItemPreview;
 
+// Busy channels allocate and free tens of thousands of items per minute,
+// so item storage comes from main-thread-only slabs with a free list
+// instead of hitting the global allocator for every single message.
+class ItemSlabPool final {
+public:
+	[[nodiscard]] void *allocate() {
+		if (!_free) {
+			grow();
+		}
+		const auto result = _free;
+		_free = _free->next;
+		return result;
+	}
+	void free(void *pointer) {
+		const auto node = static_cast<FreeNode*>(pointer);
+		node->next = _free;
+		_free = node;
+	}
+
+private:
+	struct FreeNode {
+		FreeNode *next = nullptr;
+	};
+	struct alignas(HistoryItem) Slot {
+		char data[sizeof(HistoryItem)];
+	};
+
+	void grow() {
+		auto &slab = _slabs.emplace_back(
+			std::make_unique<std::array<Slot, kPoolSlabSize>>());
+		for (auto &slot : *slab) {
+			free(slot.data);
+		}
+	}
+
+	std::vector<std::unique_ptr<std::array<Slot, kPoolSlabSize>>> _slabs;
+	FreeNode *_free = nullptr;
+
+};
+
+[[nodiscard]] ItemSlabPool &ItemPool() {
+	static auto result = ItemSlabPool();
+	return result;
+}
+
 template <typename T>
 [[nodiscard]] PreparedServiceText PrepareEmptyText(const T &) {
 	return PreparedServiceText();
@@ -89,7 +136,7 @@ template <typename T>
 }
 
 [[nodiscard]] TextWithEntities SpoilerLoginCode(TextWithEntities text) {
-	const auto r = QRegularExpression(u"([\\d\\-]{5,7})"_q);
+	static const auto r = QRegularExpression(u"([\\d\\-]{5,7})"_q);
 	const auto m = r.match(text.text);
 	if (!m.hasMatch()) {
 		return text;
@@ -137,6 +184,16 @@ template <typename T>
 
 } // namespace
 
+void *HistoryItem::operator new(std::size_t size) {
+	Expects(size == sizeof(HistoryItem));
+
+	return ItemPool().allocate();
+}
+
+void HistoryItem::operator delete(void *pointer, std::size_t size) {
+	ItemPool().free(pointer);
+}
+
 void HistoryItem::HistoryItem::Destroyer::operator()(HistoryItem *value) {
 	if (value) {
 		value->destroy();
@@ -959,6 +1016,7 @@ void HistoryItem::finishEdition(int oldKeyboardTop) {
 	//}
 
 	_history->owner().updateDependentMessages(this);
+	_history->owner().searchIndex().add(this);
 }
 
 void HistoryItem::setGroupId(MessageGroupId groupId) {
@@ -2348,19 +2406,44 @@ bool HistoryItem::translationShowRequiresRequest(LanguageId to) {
 		}
 		translationToggle(translation, false);
 		translation->to = to;
-		translation->requested = true;
 		translation->failed = false;
 		translation->text = {};
+		if (applyCachedTranslation(translation, to)) {
+			return false;
+		}
+		translation->requested = true;
 		return true;
 	} else {
 		AddComponents(HistoryMessageTranslation::Bit());
 		const auto added = Get<HistoryMessageTranslation>();
 		added->to = to;
+		if (applyCachedTranslation(added, to)) {
+			return false;
+		}
 		added->requested = true;
 		return true;
 	}
 }
 
+bool HistoryItem::applyCachedTranslation(
+		not_null<HistoryMessageTranslation*> translation,
+		LanguageId to) {
+	auto cached = _history->owner().translationFromCache(
+		fullId(),
+		to.twoLetterCode(),
+		originalText());
+	if (!cached) {
+		return false;
+	}
+	translation->requested = false;
+	translation->failed = false;
+	translation->text = std::move(*cached);
+	if (_history->translatedTo() == to) {
+		translationToggle(translation, true);
+	}
+	return true;
+}
+
 void HistoryItem::translationToggle(
 		not_null<HistoryMessageTranslation*> translation,
 		bool used) {
@@ -2372,6 +2455,13 @@ void HistoryItem::translationToggle(
 }
 
 void HistoryItem::translationDone(LanguageId to, TextWithEntities result) {
+	if (!result.empty()) {
+		_history->owner().cacheTranslation(
+			fullId(),
+			to.twoLetterCode(),
+			originalText(),
+			result);
+	}
 	const auto set = [&](not_null<HistoryMessageTranslation*> translation) {
 		if (result.empty()) {
 			translation->failed = true;
@@ -3060,6 +3150,13 @@ void HistoryItem::setTextValue(TextWithEntities text, bool force) {
 	}
 	const auto had = !_text.empty();
 	_text = std::move(text);
+
+	// Parsing grows both buffers geometrically, while the result stays
+	// attached to the item for its whole lifetime, so at rest keep them
+	// tight - bot channels with giant entity lists add up.
+	_text.text.squeeze();
+	_text.entities.squeeze();
+
 	RemoveComponents(HistoryMessageTranslation::Bit());
 	if (had || force) {
 		history()->owner().requestItemTextRefresh(this);
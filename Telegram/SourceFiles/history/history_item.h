@@ -106,6 +106,11 @@ struct HistoryItemCommonFields {
 
 class HistoryItem final : public RuntimeComposer<HistoryItem> {
 public:
+	// Items come from a slab pool, they are allocated and destroyed in
+	// bursts when histories are filled and cleared, see history_item.cpp.
+	static void *operator new(std::size_t size);
+	static void operator delete(void *pointer, std::size_t size);
+
 	[[nodiscard]] static std::unique_ptr<Data::Media> CreateMedia(
 		not_null<HistoryItem*> item,
 		const MTPMessageMedia &media);
@@ -585,6 +590,9 @@ private:
 	void translationToggle(
 		not_null<HistoryMessageTranslation*> translation,
 		bool used);
+	bool applyCachedTranslation(
+		not_null<HistoryMessageTranslation*> translation,
+		LanguageId to);
 	void setSelfDestruct(HistorySelfDestructType type, MTPint mtpTTLvalue);
 
 	void resolveDependent(not_null<HistoryServiceDependentData*> dependent);
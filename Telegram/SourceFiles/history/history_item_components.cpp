@@ -260,6 +260,12 @@ void HistoryMessageForwarded::create(const HistoryMessageVia *via) const {
 				Ui::Text::WithEntities);
 		}
 	}
+	// create() runs on every initDimensions() of the view, so skip the
+	// text shaping when the phrase didn't change since the last time.
+	if (!text.isEmpty() && (createdPhrase == phrase)) {
+		return;
+	}
+	createdPhrase = phrase;
 	text.setMarkedText(st::fwdTextStyle, phrase);
 
 	text.setLink(1, fromChannel
@@ -136,6 +136,7 @@ struct HistoryMessageForwarded : public RuntimeComponent<HistoryMessageForwarded
 	QString originalPostAuthor;
 	QString psaType;
 	MsgId originalId = 0;
+	mutable TextWithEntities createdPhrase;
 	mutable Ui::Text::String text = { 1 };
 
 	PeerData *savedFromPeer = nullptr;
@@ -115,6 +115,21 @@ void Proxy::erase(MsgId msgId) {
 	notifyUpdated();
 }
 
+void Proxy::eraseMany(const base::flat_set<MsgId> &msgIds) {
+	if (!_data || msgIds.empty()) {
+		return;
+	}
+	auto &list = resolveList();
+	const auto removed = list.eraseMany(msgIds);
+	if (!removed) {
+		return;
+	}
+	if (const auto count = list.count(); count > 0) {
+		setCount(std::max(count - removed, 0));
+	}
+	notifyUpdated();
+}
+
 void Proxy::clear() {
 	if (!_data || !count()) {
 		return;
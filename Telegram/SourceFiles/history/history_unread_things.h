@@ -57,6 +57,29 @@ public:
 	void erase(MsgId msgId) {
 		_messages.remove(msgId);
 	}
+	int eraseMany(const base::flat_set<MsgId> &msgIds) {
+		if (msgIds.empty() || _messages.empty()) {
+			return 0;
+		}
+		// Both sets are sorted, one merge pass filters the survivors
+		// instead of paying a vector shift for every erased id.
+		auto remaining = base::flat_set<MsgId>();
+		remaining.reserve(_messages.size());
+		auto skip = begin(msgIds);
+		for (const auto &id : _messages) {
+			while (skip != end(msgIds) && *skip < id) {
+				++skip;
+			}
+			if (skip == end(msgIds) || *skip != id) {
+				remaining.insert(id);
+			}
+		}
+		const auto removed = int(_messages.size() - remaining.size());
+		if (removed > 0) {
+			_messages = std::move(remaining);
+		}
+		return removed;
+	}
 	void clear() {
 		_messages.clear();
 	}
@@ -128,6 +151,7 @@ public:
 	void setCount(int count);
 	bool add(MsgId msgId, AddType type);
 	void erase(MsgId msgId);
+	void eraseMany(const base::flat_set<MsgId> &msgIds);
 	void clear();
 
 	void addSlice(const MTPmessages_Messages &slice, int alreadyLoaded);
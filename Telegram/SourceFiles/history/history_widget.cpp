@@ -127,6 +127,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mainwindow.h"
 #include "settings/business/settings_quick_replies.h"
 #include "storage/localimageloader.h"
+#include "storage/download_manager_mtproto.h"
 #include "storage/storage_account.h"
 #include "storage/file_upload.h"
 #include "storage/storage_media_prepare.h"
@@ -187,6 +188,7 @@ constexpr auto kSkipRepaintWhileScrollMs = 100;
 constexpr auto kShowMembersDropdownTimeoutMs = 300;
 constexpr auto kDisplayEditTimeWarningMs = 300 * 1000;
 constexpr auto kFullDayInMs = 86400 * 1000;
+constexpr auto kPreconnectScanLimit = 20;
 constexpr auto kSaveDraftTimeout = crl::time(1000);
 constexpr auto kSaveDraftAnywayTimeout = 5 * crl::time(1000);
 constexpr auto kSaveCloudDraftIdleTimeout = 14 * crl::time(1000);
@@ -2596,6 +2598,7 @@ void HistoryWidget::showHistory(
 		}
 
 		handlePeerUpdate();
+		preconnectToMediaDc();
 
 		session().local().readDraftsWithCursors(_history);
 		if (!applyDraft()) {
@@ -3664,6 +3667,35 @@ void HistoryWidget::historyLoaded() {
 	doneShow();
 }
 
+void HistoryWidget::preconnectToMediaDc() {
+	Expects(_history != nullptr);
+
+	// If the recent messages reference documents on some DC, the first
+	// download will likely go there, so warm that session up early.
+	const auto checkItem = [&](not_null<HistoryItem*> item) {
+		const auto media = item->media();
+		const auto document = media ? media->document() : nullptr;
+		if (document && document->hasRemoteLocation()) {
+			session().downloader().preconnect(document->remoteDcId());
+			return true;
+		}
+		return false;
+	};
+	auto checked = 0;
+	for (const auto &block : ranges::views::reverse(_history->blocks)) {
+		for (const auto &view : ranges::views::reverse(block->messages)) {
+			if (checkItem(view->data())) {
+				return;
+			} else if (++checked >= kPreconnectScanLimit) {
+				return;
+			}
+		}
+	}
+	if (const auto last = _history->lastMessage()) {
+		checkItem(last);
+	}
+}
+
 void HistoryWidget::windowShown() {
 	updateControlsGeometry();
 }
@@ -4893,7 +4925,8 @@ bool HistoryWidget::insertBotCommand(const QString &cmd) {
 	if (!insertingInlineBot) {
 		auto &textWithTags = _field->getTextWithTags();
 		TextWithTags textWithTagsToSet;
-		const auto m = QRegularExpression(u"^/[A-Za-z_0-9]{0,64}(@[A-Za-z_0-9]{0,32})?(\\s|$)"_q).match(textWithTags.text);
+		static const auto expression = QRegularExpression(u"^/[A-Za-z_0-9]{0,64}(@[A-Za-z_0-9]{0,32})?(\\s|$)"_q);
+		const auto m = expression.match(textWithTags.text);
 		if (m.hasMatch()) {
 			textWithTagsToSet = _field->getTextWithTagsPart(m.capturedLength());
 		} else {
@@ -8234,6 +8267,13 @@ void HistoryWidget::handlePeerUpdate() {
 		if (!channel->mgInfo->adminsLoaded) {
 			session().api().chatParticipants().requestAdmins(channel);
 		}
+	} else if (const auto broadcast = _peer->asBroadcast()) {
+		if (const auto linked = broadcast->linkedChat()) {
+			// Comments open into the linked megagroup, warm up its full
+			// info while the channel is on screen so the comments section
+			// doesn't start from a cold peer. Self-throttled inside.
+			linked->updateFull();
+		}
 	}
 	if (!_showAnimation) {
 		if (_unblock->isHidden() == isBlocked()
@@ -8451,7 +8491,7 @@ void HistoryWidget::addRecentBot(not_null<UserData*> bot) {
 			bots.resize(RecentInlineBotsLimit - 1);
 		}
 		bots.push_front(bot);
-		session().local().writeRecentHashtagsAndBots();
+		session().local().writeRecentHashtagsAndBotsDelayed();
 	}
 }
 
@@ -8844,6 +8884,51 @@ bool HistoryWidget::touchScroll(const QPoint &delta) {
 	return true;
 }
 
+QString HistoryWidget::runScrollBenchmark() {
+	if (!_history || !_list) {
+		return QString();
+	}
+	const auto max = _scroll->scrollTopMax();
+	if (max <= 0) {
+		return QString();
+	}
+
+	// One wheel notch worth of pixels per simulated frame, the pattern
+	// a reading scroll through the loaded slice actually produces.
+	const auto step = style::ConvertScale(120);
+	constexpr auto kMaxSamples = 2000;
+
+	const auto was = _scroll->scrollTop();
+	auto samples = std::vector<qint64>();
+	samples.reserve(std::min(max / step + 1, kMaxSamples));
+	for (auto top = max; top >= 0; top -= step) {
+		const auto started = crl::profile();
+		synteticScrollToY(top);
+		_list->repaint();
+		samples.push_back(crl::profile() - started);
+		if (samples.size() >= kMaxSamples) {
+			break;
+		}
+	}
+	synteticScrollToY(was);
+
+	ranges::sort(samples);
+	const auto milliseconds = [&](float64 percent) {
+		const auto index = int(percent * (samples.size() - 1));
+		return QString::number(samples[index] / 1000., 'f', 1);
+	};
+	const auto result = QString(
+		"Scroll benchmark: %1 frames, p50 %2 ms, p95 %3 ms, p99 %4 ms, "
+		"worst %5 ms."
+	).arg(int(samples.size())
+	).arg(milliseconds(0.5)
+	).arg(milliseconds(0.95)
+	).arg(milliseconds(0.99)
+	).arg(milliseconds(1.));
+	LOG(("%1").arg(result));
+	return result;
+}
+
 void HistoryWidget::synteticScrollToY(int y) {
 	_synteticScrollEvent = true;
 	if (_scroll->scrollTop() == y) {
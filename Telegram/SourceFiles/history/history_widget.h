@@ -211,6 +211,11 @@ public:
 
 	void escape();
 
+	// Scripted scroll over the opened chat measuring per-step paint
+	// times, used by the "scrollbench" settings code. Returns a summary
+	// of the frame-time percentiles or an empty string.
+	[[nodiscard]] QString runScrollBenchmark();
+
 	void sendBotCommand(const Bot::SendCommandRequest &request);
 	void hideSingleUseKeyboard(FullMsgId replyToId);
 	bool insertBotCommand(const QString &cmd);
@@ -405,6 +410,7 @@ private:
 	void toggleTabbedSelectorMode();
 	void recountChatWidth();
 	void handlePeerUpdate();
+	void preconnectToMediaDc();
 	bool updateCanSendMessage();
 	void setMembersShowAreaActive(bool active);
 	void handleHistoryChange(not_null<const History*> history);
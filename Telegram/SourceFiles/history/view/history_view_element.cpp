@@ -647,6 +647,9 @@ bool Element::isLastAndSelfMessage() const {
 
 void Element::setPendingResize() {
 	_flags |= Flag::NeedsResize;
+	if (_block) {
+		_block->setPendingResize();
+	}
 	if (_context == Context::History) {
 		data()->_history->setHasPendingResizedItems();
 	}
@@ -1501,6 +1504,7 @@ void Element::attachToBlock(not_null<HistoryBlock*> block, int index) {
 
 	_block = block;
 	_indexInBlock = index;
+	_block->setPendingResize();
 	_data->setMainView(this);
 	previousInBlocksChanged();
 }
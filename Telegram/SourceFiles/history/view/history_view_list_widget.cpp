@@ -83,6 +83,10 @@ constexpr auto kPreloadIfLessThanScreens = 2;
 constexpr auto kPreloadedScreensCountFull
 	= kPreloadedScreensCount + 1 + kPreloadedScreensCount;
 constexpr auto kClearUserpicsAfter = 50;
+constexpr auto kUnloadHeavyPartsPages = 2;
+constexpr auto kPreShapeIdleDelay = crl::time(200);
+constexpr auto kPreShapeTimeBudget = crl::time(4);
+constexpr auto kResizeReflowThrottle = crl::time(64);
 
 [[nodiscard]] std::unique_ptr<TranslateTracker> MaybeTranslateTracker(
 		History *history) {
@@ -316,6 +320,12 @@ ListWidget::ListWidget(
 	setAttribute(Qt::WA_AcceptTouchEvents);
 	setMouseTracking(true);
 	_scrollDateHideTimer.setCallback([this] { scrollDateHideByTimer(); });
+	_preShapeTimer.setCallback([this] { preShapeNearViewport(); });
+	_reflowTimer.setCallback([this] {
+		if (base::take(_reflowDeferred)) {
+			updateSize();
+		}
+	});
 	session().data().viewRepaintRequest(
 	) | rpl::start_with_next([this](auto view) {
 		if (view->delegate() == this) {
@@ -998,6 +1008,14 @@ void ListWidget::visibleTopBottomUpdated(
 		_userpicsCache = std::move(_userpics);
 	}
 
+	// Unload lottie animations and other heavy parts, so that items far
+	// outside the visible range stop ticking their animations.
+	const auto pages = kUnloadHeavyPartsPages;
+	const auto visibleAreaHeight = visibleBottom - visibleTop;
+	const auto from = _visibleTop - pages * visibleAreaHeight;
+	const auto till = _visibleBottom + pages * visibleAreaHeight;
+	session().data().unloadHeavyViewParts(this, from, till);
+
 	if (initializing) {
 		checkUnreadBarCreation();
 	}
@@ -1012,6 +1030,25 @@ void ListWidget::visibleTopBottomUpdated(
 	_applyUpdatedScrollState.call();
 
 	_emojiInteractions->visibleAreaUpdated(_visibleTop, _visibleBottom);
+
+	if (!_preShapeTimer.isActive()) {
+		_preShapeTimer.callOnce(kPreShapeIdleDelay);
+	}
+}
+
+void ListWidget::preShapeNearViewport() {
+	// Shape text for items outside the viewport while the scroll rests,
+	// so attaching them during a jump or fast scroll does not pay the
+	// full layout cost inside one resizeGetHeight() pass. validateText()
+	// is a no-op for views that were already shaped.
+	const auto start = crl::now();
+	for (const auto &view : _items) {
+		view->validateText();
+		if (crl::now() - start >= kPreShapeTimeBudget) {
+			_preShapeTimer.callOnce(kPreShapeIdleDelay);
+			return;
+		}
+	}
 }
 
 void ListWidget::applyUpdatedScrollState() {
@@ -1918,6 +1955,21 @@ int ListWidget::resizeGetHeight(int newWidth) {
 	update();
 
 	const auto resizeAllItems = (_itemsWidth != newWidth);
+	const auto now = crl::now();
+	if (resizeAllItems
+		&& _itemsWidth > 0
+		&& !_items.empty()
+		&& (now - _lastReflowTime < kResizeReflowThrottle)
+		&& !::Kotato::JsonSettings::GetBool("resize_exact_reflow")) {
+		// Live-dragging the window edge delivers a resize per mouse
+		// event and each one reflows every view. Keep the previous
+		// layout through the storm, the timer runs one exact pass
+		// when the width settles.
+		_reflowDeferred = true;
+		_reflowTimer.callOnce(kResizeReflowThrottle);
+		return height();
+	}
+	_lastReflowTime = now;
 	auto newHeight = 0;
 	for (const auto &view : _items) {
 		view->setY(newHeight);
@@ -489,6 +489,7 @@ private:
 
 	void checkMoveToOtherViewer();
 	void updateVisibleTopItem();
+	void preShapeNearViewport();
 	void updateItemsGeometry();
 	void updateSize();
 	void refreshAttachmentsFromTill(int from, int till);
@@ -690,6 +691,10 @@ private:
 	Ui::Animations::Simple _scrollDateOpacity;
 	SingleQueuedInvokation _scrollDateCheck;
 	base::Timer _scrollDateHideTimer;
+	base::Timer _preShapeTimer;
+	base::Timer _reflowTimer;
+	crl::time _lastReflowTime = 0;
+	bool _reflowDeferred = false;
 	Element *_scrollDateLastItem = nullptr;
 	int _scrollDateLastItemTop = 0;
 	ClickHandlerPtr _scrollDateLink;
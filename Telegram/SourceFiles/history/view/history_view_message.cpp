@@ -51,6 +51,8 @@ namespace {
 constexpr auto kPlayStatusLimit = 2;
 const auto kPsaTooltipPrefix = "cloud_lng_tooltip_psa_";
 
+auto PaintsCounters = ElementPaintsCounters();
+
 [[nodiscard]] Window::SessionController *ExtractController(
 		const ClickContext &context) {
 	const auto my = context.other.value<ClickHandlerContext>();
@@ -1056,6 +1058,10 @@ int Message::marginBottom() const {
 	return isHidden() ? 0 : st::msgMargin.bottom();
 }
 
+ElementPaintsCounters MessagePaintsCounters() {
+	return PaintsCounters;
+}
+
 void Message::draw(Painter &p, const PaintContext &context) const {
 	auto g = countGeometry();
 	if (g.width() < 1) {
@@ -1320,7 +1326,15 @@ void Message::draw(Painter &p, const PaintContext &context) const {
 		auto copy = context;
 		copy.selection = textSelection;
 		copy.highlight.range = highlightRange;
-		paintText(p, trect, copy);
+		// Partial repaints (selection, reactions, highlight animations)
+		// come with a small clip, skip the layout-heavy text paint when
+		// the remaining content rect is fully outside of it.
+		if (context.clip.isEmpty() || context.clip.intersects(trect)) {
+			++PaintsCounters.done;
+			paintText(p, trect, copy);
+		} else {
+			++PaintsCounters.culled;
+		}
 		if (mediaDisplayed && !_invertMedia) {
 			paintMedia(trect.y() + trect.height() - mediaHeight);
 			if (context.reactionInfo && !displayInfo && !_reactions) {
@@ -29,6 +29,14 @@ namespace HistoryView {
 class ViewButton;
 class WebPage;
 
+// Debug surface for partial-repaint effectiveness: how many text paints
+// ran versus how many were culled by the repaint clip.
+struct ElementPaintsCounters {
+	int64 done = 0;
+	int64 culled = 0;
+};
+[[nodiscard]] ElementPaintsCounters MessagePaintsCounters();
+
 namespace Reactions {
 class InlineList;
 } // namespace Reactions
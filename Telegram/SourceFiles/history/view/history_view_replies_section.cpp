@@ -1160,7 +1160,7 @@ void RepliesWidget::addRecentBot(not_null<UserData*> bot) {
 			bots.resize(RecentInlineBotsLimit - 1);
 		}
 		bots.push_front(bot);
-		bot->session().local().writeRecentHashtagsAndBots();
+		bot->session().local().writeRecentHashtagsAndBotsDelayed();
 	}
 }
 
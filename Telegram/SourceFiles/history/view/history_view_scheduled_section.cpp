@@ -655,7 +655,7 @@ void ScheduledWidget::addRecentBot(not_null<UserData*> bot) {
 			bots.resize(RecentInlineBotsLimit - 1);
 		}
 		bots.push_front(bot);
-		bot->session().local().writeRecentHashtagsAndBots();
+		bot->session().local().writeRecentHashtagsAndBotsDelayed();
 	}
 }
 
@@ -334,6 +334,8 @@ public:
 	// Should be called only by Data::Session.
 	virtual void updateSharedContactUserId(UserId userId) {
 	}
+	virtual void updateSharedPollResults() {
+	}
 	virtual void parentTextUpdated() {
 	}
 
@@ -422,6 +422,15 @@ void Poll::updateTexts() {
 		first ? anim::type::instant : anim::type::normal);
 }
 
+void Poll::updateSharedPollResults() {
+	// The question / answer texts and flags are intact, only counters,
+	// recent voters or the solution changed - the cached layout keeps
+	// its geometry, so refresh the numbers and repaint without a resize.
+	// For a scrolled-away view the repaint is a cheap no-op.
+	updateTexts();
+	repaint();
+}
+
 void Poll::checkQuizAnswered() {
 	if (!_voted || !_votedFromHere || !_poll->quiz() || anim::Disabled()) {
 		return;
@@ -62,6 +62,8 @@ public:
 		const ClickHandlerPtr &handler,
 		bool pressed) override;
 
+	void updateSharedPollResults() override;
+
 	void unloadHeavyPart() override;
 	bool hasHeavyPart() const override;
 
@@ -526,7 +526,8 @@ void Sticker::setupPlayer() {
 				_replacements,
 				_cachingTag,
 				countOptimalSize() * style::DevicePixelRatio(),
-				Lottie::Quality::High));
+				Lottie::Quality::High,
+				ChatHelpers::ChatLottieRenderer()));
 	} else if (_data->sticker()->isWebm()) {
 		_player = std::make_unique<WebmPlayer>(
 			_dataMedia->owner()->location(),
@@ -267,6 +267,17 @@ void ListSection::paint(
 	}
 }
 
+void ListSection::preloadHeavyParts(int from, int till) const {
+	if (!_mosaic.empty()) {
+		return;
+	}
+	auto fromIt = findItemAfterTop(from);
+	auto tillIt = findItemAfterBottom(fromIt, till);
+	for (auto it = fromIt; it != tillIt; ++it) {
+		(*it)->preloadHeavyPart();
+	}
+}
+
 void ListSection::paintFloatingHeader(
 		Painter &p,
 		int visibleTop,
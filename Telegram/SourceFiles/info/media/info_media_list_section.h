@@ -47,6 +47,8 @@ public:
 		QRect clip,
 		int outerWidth) const;
 
+	void preloadHeavyParts(int from, int till) const;
+
 	void paintFloatingHeader(Painter &p, int visibleTop, int outerWidth);
 
 private:
@@ -72,6 +72,8 @@ namespace Media {
 namespace {
 
 constexpr auto kMediaCountForSearch = 10;
+constexpr auto kQuickScrollSpeed = 2.5; // Pixels per millisecond.
+constexpr auto kQuickScrollSettleDelay = crl::time(160);
 
 } // namespace
 
@@ -147,6 +149,12 @@ ListWidget::ListWidget(
 		_provider->type(),
 		[=] { scrollDateCheck(); },
 		[=] { scrollDateHide(); })) {
+	_quickScrollTimer.setCallback([this] {
+		if (base::take(_quickScrolling)) {
+			preloadHeavyItems();
+			update();
+		}
+	});
 	start();
 }
 
@@ -623,11 +631,30 @@ auto ListWidget::foundItemInSection(
 void ListWidget::visibleTopBottomUpdated(
 		int visibleTop,
 		int visibleBottom) {
+	const auto now = crl::now();
+	const auto elapsed = now - _lastScrollTime;
+	if (elapsed > 0 && elapsed < kQuickScrollSettleDelay) {
+		// During a flick most rows leave the viewport before their
+		// thumbnails decode - hold new decode requests until the
+		// position settles, the timer repaints and preloads then.
+		const auto speed = std::abs(visibleTop - _lastScrollTop)
+			/ float64(elapsed);
+		_quickScrolling = (speed > kQuickScrollSpeed);
+	} else {
+		_quickScrolling = false;
+	}
+	_lastScrollTime = now;
+	_lastScrollTop = visibleTop;
 	_visibleTop = visibleTop;
 	_visibleBottom = visibleBottom;
 
 	checkMoveToOtherViewer();
 	clearHeavyItems();
+	if (_quickScrolling) {
+		_quickScrollTimer.callOnce(kQuickScrollSettleDelay);
+	} else {
+		preloadHeavyItems();
+	}
 
 	if (_dateBadge->goodType) {
 		updateDateBadgeFor(_visibleTop);
@@ -732,6 +759,24 @@ void ListWidget::clearHeavyItems() {
 	}
 }
 
+void ListWidget::preloadHeavyItems() {
+	// When the scrollbar jumps to an uncached part of the grid, request
+	// the thumbnails of the whole target slice right away instead of
+	// one by one as the rows get painted.
+	const auto visibleHeight = _visibleBottom - _visibleTop;
+	if (!visibleHeight) {
+		return;
+	}
+	const auto from = _visibleTop - visibleHeight;
+	const auto till = _visibleBottom + visibleHeight;
+	const auto fromSectionIt = findSectionAfterTop(from);
+	const auto tillSectionIt = findSectionAfterBottom(fromSectionIt, till);
+	for (auto it = fromSectionIt; it != tillSectionIt; ++it) {
+		const auto top = it->top();
+		it->preloadHeavyParts(from - top, till - top);
+	}
+}
+
 ListScrollTopState ListWidget::countScrollState() const {
 	if (_sections.empty() || _visibleTop <= 0) {
 		return {};
@@ -803,6 +848,7 @@ void ListWidget::paintEvent(QPaintEvent *e) {
 		&_dragSelected,
 		_dragSelectAction
 	};
+	context.layoutContext.quickScrolling = _quickScrolling;
 	for (auto it = fromSectionIt; it != tillSectionIt; ++it) {
 		auto top = it->top();
 		p.translate(0, top);
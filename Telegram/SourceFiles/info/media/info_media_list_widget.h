@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #pragma once
 
+#include "base/timer.h"
 #include "ui/rp_widget.h"
 #include "ui/widgets/tooltip.h"
 #include "info/media/info_media_widget.h"
@@ -265,6 +266,7 @@ private:
 	void validateTrippleClickStartTime();
 	void checkMoveToOtherViewer();
 	void clearHeavyItems();
+	void preloadHeavyItems();
 
 	void setActionBoxWeak(QPointer<Ui::BoxContent> box);
 
@@ -280,6 +282,11 @@ private:
 	ListScrollTopState _scrollTopState;
 	rpl::event_stream<int> _scrollToRequests;
 
+	base::Timer _quickScrollTimer;
+	crl::time _lastScrollTime = 0;
+	int _lastScrollTop = 0;
+	bool _quickScrolling = false;
+
 	MouseAction _mouseAction = MouseAction::None;
 	TextSelectType _mouseSelectType = TextSelectType::Letters;
 	QPoint _mousePosition;
@@ -102,6 +102,7 @@ void Inner::visibleTopBottomUpdated(
 	if (_visibleTop != visibleTop) {
 		_visibleTop = visibleTop;
 		_lastScrolledAt = crl::now();
+		preloadImages();
 		update();
 	}
 }
@@ -450,9 +451,31 @@ void Inner::deleteUnusedInlineLayouts() {
 }
 
 void Inner::preloadImages() {
-	_mosaic.forEach([](not_null<const ItemBase*> item) {
-		item->preload();
-	});
+	// A single slice may bring 50 heavy results, so only load the media
+	// for the rows around the visible part of the strip, the rest gets
+	// requested as the user scrolls to it.
+	const auto visibleTop = _visibleTop;
+	const auto visibleBottom = (_visibleBottom > _visibleTop)
+		? _visibleBottom
+		: (_visibleTop + st::emojiPanMaxHeight);
+	auto top = st::stickerPanPadding;
+	auto preloadedAfter = 0;
+	for (auto row = 0, rows = _mosaic.rowsCount(); row != rows; ++row) {
+		const auto height = _mosaic.rowHeightAt(row);
+		const auto visible = (top < visibleBottom)
+			&& (top + height > visibleTop);
+		top += height;
+		if (!visible && (top <= visibleTop || ++preloadedAfter > 1)) {
+			continue;
+		}
+		for (auto column = 0;; ++column) {
+			if (const auto item = _mosaic.maybeItemAt(row, column)) {
+				item->preload();
+			} else {
+				break;
+			}
+		}
+	}
 }
 
 void Inner::hideInlineRowsPanel() {
@@ -7,6 +7,7 @@ https://github.com/kotatogram/kotatogram-desktop/blob/dev/LEGAL
 */
 #include "kotato/kotato_radius.h"
 
+#include "base/flat_map.h"
 #include "kotato/kotato_settings.h"
 #include "ui/painter.h"
 #include "styles/style_chat.h"
@@ -24,9 +25,16 @@ struct Radius {
 
 Radius radius;
 
+// Rendering a tail tessellates a rounded rect, so keep the results
+// around, they are requested on every paint of a tailed bubble.
+base::flat_map<QRgb, QPixmap> tailLeftCache;
+base::flat_map<QRgb, QPixmap> tailRightCache;
+
 } // namespace
 
 void RefreshRadius() {
+	tailLeftCache.clear();
+	tailRightCache.clear();
 	radius.userpicRadius = float64(JsonSettings::GetInt("userpic_corner_radius")) / 100.0;
 	radius.forumUserpicRadius = float64(JsonSettings::GetInt("userpic_corner_radius_forum")) / 100.0;
 	radius.useDefaultRadiusForForum = JsonSettings::GetBool("userpic_corner_radius_forum_use_default");
@@ -97,6 +105,12 @@ style::point UserpicOnlineBadgeSkip() {
 
 QPixmap MessageTailLeft(style::color color) {
 	const auto tail = st::historyBubbleTailInLeft;
+	const auto key = color->c.rgba();
+	const auto i = tailLeftCache.find(key);
+	if (i != end(tailLeftCache)
+		&& i->second.size() == QSize(tail.width(), tail.height())) {
+		return i->second;
+	}
 	QImage rect(tail.width(), tail.height(), QImage::Format_ARGB32_Premultiplied);
 	rect.fill(color->c);
 	{
@@ -114,11 +128,19 @@ QPixmap MessageTailLeft(style::color color) {
 			st::msgPhotoSize * radius.userpicRadius,
 			st::msgPhotoSize * radius.userpicRadius);
 	}
-	return QPixmap::fromImage(rect);
+	auto result = QPixmap::fromImage(rect);
+	tailLeftCache[key] = result;
+	return result;
 }
 
 QPixmap MessageTailRight(style::color color) {
 	const auto tail = st::historyBubbleTailInRight;
+	const auto key = color->c.rgba();
+	const auto i = tailRightCache.find(key);
+	if (i != end(tailRightCache)
+		&& i->second.size() == QSize(tail.width(), tail.height())) {
+		return i->second;
+	}
 	QImage rect(tail.width(), tail.height(), QImage::Format_ARGB32_Premultiplied);
 	rect.fill(color->c);
 	{
@@ -136,7 +158,9 @@ QPixmap MessageTailRight(style::color color) {
 			st::msgPhotoSize * radius.userpicRadius,
 			st::msgPhotoSize * radius.userpicRadius);
 	}
-	return QPixmap::fromImage(rect);
+	auto result = QPixmap::fromImage(rect);
+	tailRightCache[key] = result;
+	return result;
 }
 
 
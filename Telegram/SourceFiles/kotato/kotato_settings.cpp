@@ -316,9 +316,19 @@ const std::map<QString, Definition, std::greater<QString>> DefinitionMap {
 		.type = SettingType::IntSetting,
 		.defaultValue = 0,
 		.limitHandler = NetSpeedBoostConv(IntLimit(0, 3)), }},
+	{ "media_preload_screens", {
+		.type = SettingType::IntSetting,
+		.defaultValue = 2,
+		.limitHandler = IntLimit(0, 8, 2), }},
+	{ "calls_frame_time_overlay", {
+		.type = SettingType::BoolSetting,
+		.defaultValue = false, }},
 	{ "disable_up_edit", {
 		.type = SettingType::BoolSetting,
 		.defaultValue = false, }},
+	{ "resize_exact_reflow", {
+		.type = SettingType::BoolSetting,
+		.defaultValue = false, }},
 	{ "replaces", {
 		.type = SettingType::QJsonArraySetting,
 		.limitHandler = ReplacesLimit(), }},
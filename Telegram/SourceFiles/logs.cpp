@@ -13,6 +13,10 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/launcher.h"
 #include "mtproto/facade.h"
 
+#include <QtCore/QWaitCondition>
+#include <deque>
+#include <thread>
+
 namespace {
 
 std::atomic<int> ThreadCounter/* = 0*/;
@@ -254,6 +258,99 @@ NEW LOGGING INSTANCE STARTED!!!\n\
 
 LogsDataFields *LogsData = 0;
 
+// Debug categories can produce thousands of lines per second and each
+// one used to be written and flushed synchronously on the calling
+// thread. Queue the formatted lines into a bounded ring instead and let
+// one background thread write them out in batches, one flush per run of
+// same-type lines. The main log keeps its synchronous durable write, a
+// crash right after a LOG() should still have the line on disk.
+class DeferredLogsWriter final {
+public:
+	void enqueue(LogDataType type, const QString &msg) {
+		QMutexLocker lock(&_mutex);
+		if (_stopped) {
+			return;
+		} else if (!_thread.joinable()) {
+			_thread = std::thread([=] { loop(); });
+		}
+		if (_ring.size() >= kRingLimit) {
+			_ring.pop_front();
+			++_dropped;
+		}
+		_ring.push_back({ type, msg });
+		_condition.wakeOne();
+	}
+
+	void stop() {
+		{
+			QMutexLocker lock(&_mutex);
+			if (_stopped || !_thread.joinable()) {
+				_stopped = true;
+				return;
+			}
+			_stopped = true;
+			_condition.wakeOne();
+		}
+		_thread.join();
+	}
+
+private:
+	static constexpr auto kRingLimit = 8192;
+
+	void loop() {
+		QMutexLocker lock(&_mutex);
+		while (true) {
+			while (_ring.empty() && !_stopped) {
+				_condition.wait(&_mutex);
+			}
+			auto taken = std::move(_ring);
+			_ring.clear();
+			const auto dropped = std::exchange(_dropped, 0);
+			const auto stopped = _stopped;
+			lock.unlock();
+			flush(taken, dropped);
+			if (stopped) {
+				return;
+			}
+			lock.relock();
+		}
+	}
+
+	void flush(
+			const std::deque<std::pair<LogDataType, QString>> &taken,
+			int dropped) {
+		if (!LogsData) {
+			return;
+		} else if (dropped > 0) {
+			LogsData->write(LogDataDebug, QString(
+				"%1 (logs ring overflow, dropped %2 lines)\n"
+			).arg(_logsEntryStart()).arg(dropped));
+		}
+		auto batchType = LogDataDebug;
+		auto batch = QString();
+		for (const auto &[type, msg] : taken) {
+			if (type != batchType && !batch.isEmpty()) {
+				LogsData->write(batchType, batch);
+				batch = QString();
+			}
+			batchType = type;
+			batch += msg;
+		}
+		if (!batch.isEmpty()) {
+			LogsData->write(batchType, batch);
+		}
+	}
+
+	QMutex _mutex;
+	QWaitCondition _condition;
+	std::deque<std::pair<LogDataType, QString>> _ring;
+	int _dropped = 0;
+	bool _stopped = false;
+	std::thread _thread;
+
+};
+DeferredLogsWriter DeferredWriter;
+
 using LogsInMemoryList = QList<QPair<LogDataType, QString>>;
 LogsInMemoryList *LogsInMemory = 0;
 LogsInMemoryList *DeletedLogsInMemory = SharedMemoryLocation<LogsInMemoryList, 0>();
@@ -262,8 +359,10 @@ QString LogsBeforeSingleInstanceChecked; // LogsInMemory already dumped in LogsD
 
 void _logsWrite(LogDataType type, const QString &msg) {
 	if (LogsData && (type == LogDataMain || LogsStartIndexChosen < 0)) {
-		if (type == LogDataMain || Logs::DebugEnabled()) {
+		if (type == LogDataMain) {
 			LogsData->write(type, msg);
+		} else if (Logs::DebugEnabled()) {
+			DeferredWriter.enqueue(type, msg);
 		}
 	} else if (LogsInMemory != DeletedLogsInMemory) {
 		if (!LogsInMemory) {
@@ -426,6 +525,8 @@ void start() {
 }
 
 void finish() {
+	DeferredWriter.stop();
+
 	delete LogsData;
 	LogsData = 0;
 
@@ -37,6 +37,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "window/window_controller.h"
 #include "window/window_lock_widgets.h"
 #include "base/unixtime.h"
+#include "base/call_delayed.h"
 #include "calls/calls_instance.h"
 #include "support/support_helper.h"
 #include "lang/lang_keys.h"
@@ -53,6 +54,7 @@ namespace Main {
 namespace {
 
 constexpr auto kTmpPasswordReserveTime = TimeId(10);
+constexpr auto kDeferredStickersReadDelay = crl::time(1000);
 
 [[nodiscard]] QString ValidatedInternalLinksDomain(
 		not_null<const Session*> session) {
@@ -157,19 +159,25 @@ Session::Session(
 
 		// Storage::Account uses Main::Account::session() in those methods.
 		// So they can't be called during Main::Session construction.
-		local().readInstalledStickers();
-		local().readInstalledMasks();
-		local().readInstalledCustomEmoji();
-		local().readFeaturedStickers();
-		local().readFeaturedCustomEmoji();
-		local().readRecentStickers();
-		local().readRecentMasks();
-		local().readFavedStickers();
-		local().readSavedGifs();
-		data().stickers().notifyUpdated(Data::StickersType::Stickers);
-		data().stickers().notifyUpdated(Data::StickersType::Masks);
-		data().stickers().notifyUpdated(Data::StickersType::Emoji);
-		data().stickers().notifySavedGifsUpdated();
+		//
+		// Nothing on the first painted frame needs the sticker and gif
+		// blobs, so keep their decryption and parsing off the startup
+		// path and let the window paint with the dialogs first.
+		base::call_delayed(kDeferredStickersReadDelay, this, [=] {
+			local().readInstalledStickers();
+			local().readInstalledMasks();
+			local().readInstalledCustomEmoji();
+			local().readFeaturedStickers();
+			local().readFeaturedCustomEmoji();
+			local().readRecentStickers();
+			local().readRecentMasks();
+			local().readFavedStickers();
+			local().readSavedGifs();
+			data().stickers().notifyUpdated(Data::StickersType::Stickers);
+			data().stickers().notifyUpdated(Data::StickersType::Masks);
+			data().stickers().notifyUpdated(Data::StickersType::Emoji);
+			data().stickers().notifySavedGifsUpdated();
+		});
 	});
 
 #ifndef TDESKTOP_DISABLE_SPELLCHECK
@@ -1101,8 +1101,28 @@ void MainWidget::setReadyChatBackground(
 		? Data::DefaultWallPaper()
 		: background;
 
-	Background()->set(ready, std::move(image));
-	const auto tile = Data::IsLegacy1DefaultWallPaper(ready);
+	if (!image.isNull()) {
+		// Downscaling a 4K source to the storage limit is the heavy part
+		// of applying a custom background, so keep it off the main thread
+		// here - set() detects an already preprocessed image and skips it.
+		crl::async([=, image = std::move(image)]() mutable {
+			image = Ui::PreprocessBackgroundImage(std::move(image));
+			crl::on_main(this, [=, image = std::move(image)]() mutable {
+				applyReadyChatBackground(ready, std::move(image));
+			});
+		});
+		return;
+	}
+	applyReadyChatBackground(ready, std::move(image));
+}
+
+void MainWidget::applyReadyChatBackground(
+		const Data::WallPaper &background,
+		QImage &&image) {
+	using namespace Window::Theme;
+
+	Background()->set(background, std::move(image));
+	const auto tile = Data::IsLegacy1DefaultWallPaper(background);
 	Background()->setTile(tile);
 	Ui::ForceFullRepaint(this);
 }
@@ -2033,6 +2053,10 @@ void MainWidget::checkActivation() {
 	}
 }
 
+QString MainWidget::runScrollBenchmark() {
+	return _history->runScrollBenchmark();
+}
+
 void MainWidget::showAnimated(QPixmap oldContentCache, bool back) {
 	_showAnimation = nullptr;
 
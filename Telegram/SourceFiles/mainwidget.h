@@ -143,6 +143,9 @@ public:
 	void dialogsToUp();
 	void checkActivation();
 
+	// Used by the "scrollbench" settings code.
+	[[nodiscard]] QString runScrollBenchmark();
+
 	[[nodiscard]] PeerData *peer() const;
 	[[nodiscard]] Ui::ChatTheme *customChatTheme() const;
 
@@ -330,6 +333,9 @@ private:
 	void setReadyChatBackground(
 		const Data::WallPaper &background,
 		QImage &&image);
+	void applyReadyChatBackground(
+		const Data::WallPaper &background,
+		QImage &&image);
 
 	void handleHistoryBack();
 	bool showHistoryInDifferentWindow(
@@ -37,6 +37,10 @@ constexpr auto kSuppressRatioSong = 0.05;
 constexpr auto kWaveformCounterBufferSize = 256 * 1024;
 
 QMutex AudioMutex;
+
+// How many times the fader (the OpenAL feeding thread) found AudioMutex
+// taken by another thread and had to defer its pass instead of blocking.
+std::atomic<int64> FaderDefersCount;
 ALCdevice *AudioDevice = nullptr;
 ALCcontext *AudioContext = nullptr;
 Webrtc::DeviceResolvedId AudioDeviceLastUsedId{
@@ -227,6 +231,10 @@ bool SupportsSpeedControl() {
 	return result;
 }
 
+int64 FaderDefersCounter() {
+	return FaderDefersCount.load(std::memory_order_relaxed);
+}
+
 } // namespace Audio
 
 namespace Player {
@@ -238,6 +246,7 @@ constexpr auto kFadeDuration = crl::time(500);
 constexpr auto kCheckPlaybackPositionTimeout = crl::time(100); // 100ms per check audio position
 constexpr auto kCheckPlaybackPositionDelta = 2400LL; // update position called each 2400 samples
 constexpr auto kCheckFadingTimeout = crl::time(7); // 7ms
+constexpr auto kFaderDeferTimeout = crl::time(2); // retry after contention
 
 rpl::event_stream<AudioMsgId> UpdatedStream;
 
@@ -1100,7 +1109,15 @@ void Fader::onInit() {
 }
 
 void Fader::onTimer() {
-	QMutexLocker lock(&AudioMutex);
+	// Never block the audio thread on the UI thread: if another thread
+	// holds the mutex right now, count the defer and retry shortly
+	// instead of parking here while the stream drains.
+	if (!AudioMutex.tryLock()) {
+		FaderDefersCount.fetch_add(1, std::memory_order_relaxed);
+		_timer.start(kFaderDeferTimeout);
+		return;
+	}
+	const auto unlocker = gsl::finally([] { AudioMutex.unlock(); });
 	if (!mixer()) return;
 
 	constexpr auto kMediaPlayerSuppressDuration = crl::time(150);
@@ -1558,14 +1575,8 @@ public:
 
 		auto fmt = format();
 		auto peak = uint16(0);
-		auto callback = [&](uint16 sample) {
-			accumulate_max(peak, sample);
-			sumbytes += Media::Player::kWaveformSamplesCount;
-			if (sumbytes >= countbytes) {
-				sumbytes -= countbytes;
-				peaks.push_back(peak);
-				peak = 0;
-			}
+		auto bucketDone = [&](uint16 bucketPeak) {
+			peaks.push_back(bucketPeak);
 		};
 		while (processed < countbytes) {
 			const auto result = readMore();
@@ -1580,9 +1591,21 @@ public:
 			const auto sampleBytes = v::get<bytes::const_span>(result);
 			Assert(!sampleBytes.empty());
 			if (fmt == AL_FORMAT_MONO8 || fmt == AL_FORMAT_STEREO8) {
-				Media::Audio::IterateSamples<uchar>(sampleBytes, callback);
+				Media::Audio::IterateSampleBlocks<uchar>(
+					sampleBytes,
+					sumbytes,
+					peak,
+					Media::Player::kWaveformSamplesCount,
+					countbytes,
+					bucketDone);
 			} else if (fmt == AL_FORMAT_MONO16 || fmt == AL_FORMAT_STEREO16) {
-				Media::Audio::IterateSamples<int16>(sampleBytes, callback);
+				Media::Audio::IterateSampleBlocks<int16>(
+					sampleBytes,
+					sumbytes,
+					peak,
+					Media::Player::kWaveformSamplesCount,
+					countbytes,
+					bucketDone);
 			}
 			processed += sampleBytes.size();
 		}
@@ -55,6 +55,10 @@ void ScheduleDetachIfNotUsedSafe();
 void StopDetachIfNotUsedSafe();
 bool SupportsSpeedControl();
 
+// Thread: Any. How many fader passes were deferred because another
+// thread was holding AudioMutex, a proxy for potential underruns.
+[[nodiscard]] int64 FaderDefersCounter();
+
 } // namespace Audio
 
 namespace Player {
@@ -420,5 +424,52 @@ void IterateSamples(bytes::const_span bytes, Callback &&callback) {
 	}
 }
 
+// Peak over a contiguous block of samples. The plain max-reduction loop
+// is recognized by the compilers we ship with and turns into SSE2/NEON
+// code, which is why the waveform counter feeds blocks through here
+// instead of calling back per sample.
+template <typename SampleType>
+[[nodiscard]] uint16 BlockPeak(
+		const SampleType *samples,
+		int64 count) {
+	auto peak = uint16(0);
+	for (auto i = int64(0); i != count; ++i) {
+		const auto value = ReadOneSample(samples[i]);
+		peak = (value > peak) ? value : peak;
+	}
+	return peak;
+}
+
+// Walks samples in bucket-sized blocks, reporting the peak of each
+// completed bucket. The bucket position is carried in sumbytes exactly
+// as the per-sample version did: each sample adds samplesCountTotal and
+// a bucket completes when it reaches bucketSize.
+template <typename SampleType, typename Callback>
+void IterateSampleBlocks(
+		bytes::const_span bytes,
+		int64 &sumbytes,
+		uint16 &peak,
+		int64 samplesCountTotal,
+		int64 bucketSize,
+		Callback &&bucketDone) {
+	auto samples = reinterpret_cast<const SampleType*>(bytes.data());
+	auto left = int64(bytes.size() / sizeof(SampleType));
+	while (left > 0) {
+		const auto tillBucket = (bucketSize - sumbytes + samplesCountTotal - 1)
+			/ samplesCountTotal;
+		const auto block = std::min(left, tillBucket);
+		const auto blockPeak = BlockPeak(samples, block);
+		peak = (blockPeak > peak) ? blockPeak : peak;
+		sumbytes += block * samplesCountTotal;
+		samples += block;
+		left -= block;
+		if (sumbytes >= bucketSize) {
+			sumbytes -= bucketSize;
+			bucketDone(peak);
+			peak = 0;
+		}
+	}
+}
+
 } // namespace Audio
 } // namespace Media
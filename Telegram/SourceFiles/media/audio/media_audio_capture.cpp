@@ -28,6 +28,12 @@ constexpr auto kCaptureFadeInDuration = crl::time(300);
 constexpr auto kCaptureBufferSlice = 256 * 1024;
 constexpr auto kCaptureUpdateDelta = crl::time(100);
 
+// The device ring buffer must survive the encoder thread being starved
+// under CPU load - OpenAL silently drops samples once it overflows,
+// which came up as corrupted recordings. Two seconds of mono16 is only
+// ~190 KB and covers any realistic scheduling stall.
+constexpr auto kCaptureDeviceBufferSeconds = 2;
+
 Instance *CaptureInstance = nullptr;
 
 bool ErrorHappened(ALCdevice *device) {
@@ -313,7 +319,7 @@ void Instance::Inner::start(
 		utf.empty() ? nullptr : utf.c_str(),
 		kCaptureFrequency,
 		AL_FORMAT_MONO16,
-		kCaptureFrequency / 5);
+		kCaptureFrequency * kCaptureDeviceBufferSeconds);
 	if (!d->device) {
 		LOG(("Audio Error: capture device not present!"));
 		fail();
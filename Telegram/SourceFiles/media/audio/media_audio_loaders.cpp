@@ -181,6 +181,10 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 		accumulatedCount = accumulated.size() / sampleSize;
 	}
 	const auto accumulateTill = l->bytesPerBuffer();
+	// One buffer worth of samples is accumulated here several times per
+	// second for hours of music playback, so allocate it in one go
+	// instead of letting the repeated appends grow it step by step.
+	accumulated.reserve(accumulateTill);
 	while (accumulated.size() < accumulateTill) {
 		using Error = AudioPlayerLoader::ReadError;
 		const auto result = l->readMore();
@@ -499,6 +503,7 @@ Mixer::Track::WithSpeed Loaders::rebufferOnSpeedChange(
 		auto accumulatedCount = int64();
 		const auto sampleSize = l->sampleSize();
 		const auto accumulateTill = l->bytesPerBuffer();
+		accumulated.reserve(accumulateTill);
 		while (accumulated.size() < accumulateTill) {
 			const auto result = l->readMore();
 			const auto sampleBytes = v::is<bytes::const_span>(result)
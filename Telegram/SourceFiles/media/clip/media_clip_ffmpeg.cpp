@@ -265,6 +265,14 @@ bool FFMpegReaderImplementation::renderFrame(
 	return true;
 }
 
+QSize FFMpegReaderImplementation::frameSize() const {
+	if (!_frameRead || !_frame) {
+		return QSize();
+	}
+	const auto size = QSize(_frame->width, _frame->height);
+	return rotationSwapWidthHeight() ? size.transposed() : size;
+}
+
 FFMpegReaderImplementation::Rotation FFMpegReaderImplementation::rotationFromDegrees(int degrees) const {
 	switch (degrees) {
 	case 90: return Rotation::Degrees90;
@@ -39,6 +39,9 @@ public:
 		int &index,
 		const QSize &size) override;
 
+	// Display-oriented size of the last read (not yet rendered) frame.
+	[[nodiscard]] QSize frameSize() const;
+
 	crl::time durationMs() const override;
 
 	bool start(Mode mode, crl::time &positionMs) override;
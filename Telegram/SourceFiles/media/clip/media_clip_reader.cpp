@@ -36,6 +36,7 @@ namespace {
 constexpr auto kClipThreadsCount = 8;
 constexpr auto kAverageGifSize = 320 * 240;
 constexpr auto kWaitBeforeGifPause = crl::time(200);
+constexpr auto kSentCoverSideLimit = 1280;
 
 QImage PrepareFrame(
 		const FrameRequest &request,
@@ -989,11 +990,23 @@ Ui::PreparedFileInformation PrepareForSending(
 			auto hasAlpha = false;
 			auto readResult = reader->readFramesTill(-1, crl::now());
 			auto readFrame = (readResult == internal::ReaderImplementation::ReadResult::Success);
-			if (readFrame && reader->renderFrame(result.thumbnail, hasAlpha, index, QSize())) {
+			const auto dimensions = reader->frameSize();
+			// A 4K clip doesn't need a 4K cover - cap the rendered frame
+			// the way photo uploads are capped, the conversion and the
+			// blur / scale passes downstream run on every pixel of it.
+			const auto limited = (dimensions.width() > kSentCoverSideLimit
+				|| dimensions.height() > kSentCoverSideLimit)
+				? dimensions.scaled(
+					kSentCoverSideLimit,
+					kSentCoverSideLimit,
+					Qt::KeepAspectRatio)
+				: QSize();
+			if (readFrame && reader->renderFrame(result.thumbnail, hasAlpha, index, limited)) {
 				if (hasAlpha && !result.isWebmSticker) {
 					result.thumbnail = Images::Opaque(std::move(result.thumbnail));
 				}
 				result.duration = durationMs;
+				result.dimensions = dimensions;
 			}
 
 			result.supportsStreaming = CheckStreamingSupport(
@@ -336,7 +336,7 @@ void ReplyArea::sendInlineResult(
 			bots.resize(RecentInlineBotsLimit - 1);
 		}
 		bots.push_front(bot);
-		bot->session().local().writeRecentHashtagsAndBots();
+		bot->session().local().writeRecentHashtagsAndBotsDelayed();
 	}
 	finishSending();
 	_controls->clear();
@@ -279,11 +279,15 @@ void File::Context::start(StartOptions options) {
 	if (unroll()) {
 		return;
 	}
+	// Align the AVIO buffer with the 128 KB download parts, so each part
+	// is served by a single Reader::fill pass instead of being re-walked
+	// in 4 KB chunks through the slices machinery.
 	auto format = FFmpeg::MakeFormatPointer(
 		static_cast<void*>(this),
 		&Context::Read,
 		nullptr,
-		options.seekable ? &Context::Seek : nullptr);
+		options.seekable ? &Context::Seek : nullptr,
+		Loader::kPartSize);
 	if (!format) {
 		return fail(Error::OpenFailed);
 	}
@@ -22,6 +22,7 @@ namespace {
 constexpr auto kBufferFor = 3 * crl::time(1000);
 constexpr auto kLoadInAdvanceForRemote = 32 * crl::time(1000);
 constexpr auto kLoadInAdvanceForLocal = 5 * crl::time(1000);
+constexpr auto kMaxLoadInAdvanceDoublings = 2;
 constexpr auto kMsFrequency = 1000; // 1000 ms per second.
 
 // If we played for 3 seconds and got stuck it looks like we're loading
@@ -568,7 +569,13 @@ void Player::savePreviousReceivedTill(
 }
 
 crl::time Player::loadInAdvanceFor() const {
-	return _remoteLoader ? kLoadInAdvanceForRemote : kLoadInAdvanceForLocal;
+	if (!_remoteLoader) {
+		return kLoadInAdvanceForLocal;
+	}
+	// Each stall doubles the load-ahead window (up to a cap), so on a
+	// slow connection playback buffers deeper instead of stalling again.
+	const auto doublings = std::min(_stallCount, kMaxLoadInAdvanceDoublings);
+	return kLoadInAdvanceForRemote << doublings;
 }
 
 crl::time Player::computeTotalDuration() const {
@@ -721,6 +728,13 @@ void Player::start() {
 	) | rpl::filter([=] {
 		return !bothReceivedEnough(kBufferFor);
 	}) | rpl::start_with_next([=] {
+		if (!_pausedByWaitingForData) {
+			++_stallCount;
+			DEBUG_LOG(("Streaming Player: stall %1, "
+				"load in advance %2ms."
+				).arg(_stallCount
+				).arg(loadInAdvanceFor()));
+		}
 		_pausedByWaitingForData = true;
 		updatePausedState();
 		_updates.fire({ WaitingForData{ true } });
@@ -822,6 +836,10 @@ bool Player::buffering() const {
 	return _pausedByWaitingForData;
 }
 
+int Player::stallCount() const {
+	return _stallCount;
+}
+
 bool Player::paused() const {
 	return _pausedByUser && active();
 }
@@ -54,6 +54,9 @@ public:
 	[[nodiscard]] bool playing() const;
 	[[nodiscard]] bool buffering() const;
 	[[nodiscard]] bool paused() const;
+
+	// How many times playback was paused by waiting for data.
+	[[nodiscard]] int stallCount() const;
 	[[nodiscard]] std::optional<Error> failed() const;
 	[[nodiscard]] bool finished() const;
 
@@ -194,6 +197,7 @@ private:
 	bool _audioFinished = false;
 	bool _videoFinished = false;
 	bool _remoteLoader = false;
+	int _stallCount = 0;
 
 	crl::time _startedTime = kTimeUnknown;
 	crl::time _pausedTime = kTimeUnknown;
@@ -1332,6 +1332,11 @@ bool Reader::processCacheResults() {
 		return false;
 	}
 	for (auto &[sliceNumber, result] : loaded) {
+		if (result.empty()) {
+			++_cacheSliceMisses;
+		} else {
+			++_cacheSliceHits;
+		}
 		_slices.processCacheResult(sliceNumber, std::move(result));
 	}
 	if (!sizes.empty()) {
@@ -1392,6 +1397,11 @@ void Reader::finalizeCache() {
 }
 
 Reader::~Reader() {
+	if (_cacheSliceHits || _cacheSliceMisses) {
+		DEBUG_LOG(("Streaming Reader: cache slices hit: %1, miss: %2."
+			).arg(_cacheSliceHits
+			).arg(_cacheSliceMisses));
+	}
 	finalizeCache();
 }
 
@@ -253,6 +253,8 @@ private:
 
 	// Even if streaming had failed, the Reader can work for the downloader.
 	std::optional<Error> _streamingError;
+	int _cacheSliceHits = 0;
+	int _cacheSliceMisses = 0;
 
 	// In case streaming is active both main and streaming threads have work.
 	// In case only downloader is active, all work is done on main thread.
@@ -849,17 +849,12 @@ auto VideoTrack::Shared::prepareState(
 		return v::is<PrepareNextCheck>(result) ? PrepareState() : result;
 	};
 
-	switch (counter()) {
-	case 0: return finishPrepare(1);
-	case 1: return prepareNext(2);
-	case 2: return finishPrepare(2);
-	case 3: return prepareNext(3);
-	case 4: return finishPrepare(3);
-	case 5: return prepareNext(0);
-	case 6: return finishPrepare(0);
-	case 7: return prepareNext(1);
-	}
-	Unexpected("Counter value in VideoTrack::Shared::prepareState.");
+	const auto counterValue = counter();
+	Assert(counterValue >= 0 && counterValue < 2 * kFramesCount);
+	const auto index = counterValue / 2;
+	return (counterValue % 2 == 0)
+		? finishPrepare((index + 1) % kFramesCount)
+		: prepareNext((index + 2) % kFramesCount);
 }
 
 // Sometimes main thread subscribes to check frame requests before
@@ -919,17 +914,12 @@ auto VideoTrack::Shared::presentFrame(
 		return { kTimeUnknown, (frame->position - time.trackTime + 1) };
 	};
 
-	switch (counter()) {
-	case 0: return present(0, 1);
-	case 1: return nextCheckDelay(2);
-	case 2: return present(2, 2);
-	case 3: return nextCheckDelay(3);
-	case 4: return present(4, 3);
-	case 5: return nextCheckDelay(0);
-	case 6: return present(6, 0);
-	case 7: return nextCheckDelay(1);
-	}
-	Unexpected("Counter value in VideoTrack::Shared::prepareState.");
+	const auto counterValue = counter();
+	Assert(counterValue >= 0 && counterValue < 2 * kFramesCount);
+	const auto index = counterValue / 2;
+	return (counterValue % 2 == 0)
+		? present(counterValue, (index + 1) % kFramesCount)
+		: nextCheckDelay((index + 2) % kFramesCount);
 }
 
 crl::time VideoTrack::Shared::nextFrameDisplayTime() const {
@@ -947,17 +937,11 @@ crl::time VideoTrack::Shared::nextFrameDisplayTime() const {
 		return frame->display;
 	};
 
-	switch (counter()) {
-	case 0: return kTimeUnknown;
-	case 1: return frameDisplayTime(1);
-	case 2: return kTimeUnknown;
-	case 3: return frameDisplayTime(3);
-	case 4: return kTimeUnknown;
-	case 5: return frameDisplayTime(5);
-	case 6: return kTimeUnknown;
-	case 7: return frameDisplayTime(7);
-	}
-	Unexpected("Counter value in VideoTrack::Shared::nextFrameDisplayTime.");
+	const auto counterValue = counter();
+	Assert(counterValue >= 0 && counterValue < 2 * kFramesCount);
+	return (counterValue % 2 == 0)
+		? kTimeUnknown
+		: frameDisplayTime(counterValue);
 }
 
 crl::time VideoTrack::Shared::markFrameDisplayed(crl::time now) {
@@ -972,17 +956,11 @@ crl::time VideoTrack::Shared::markFrameDisplayed(crl::time now) {
 		return frame->position;
 	};
 
-	switch (counter()) {
-	case 0: Unexpected("Value 0 in VideoTrack::Shared::markFrameDisplayed.");
-	case 1: return mark(1);
-	case 2: Unexpected("Value 2 in VideoTrack::Shared::markFrameDisplayed.");
-	case 3: return mark(3);
-	case 4: Unexpected("Value 4 in VideoTrack::Shared::markFrameDisplayed.");
-	case 5: return mark(5);
-	case 6: Unexpected("Value 6 in VideoTrack::Shared::markFrameDisplayed.");
-	case 7: return mark(7);
+	const auto counterValue = counter();
+	if (counterValue < 0 || counterValue % 2 == 0) {
+		Unexpected("Counter value in VideoTrack::Shared::markFrameDisplayed.");
 	}
-	Unexpected("Counter value in VideoTrack::Shared::markFrameDisplayed.");
+	return mark(counterValue);
 }
 
 void VideoTrack::Shared::addTimelineDelay(crl::time delayed) {
@@ -1003,17 +981,11 @@ void VideoTrack::Shared::addTimelineDelay(crl::time delayed) {
 		//frame->display = countFrameDisplayTime(frame->index);
 	};
 
-	switch (counter()) {
-	case 0: Unexpected("Value 0 in VideoTrack::Shared::addTimelineDelay.");
-	case 1: return recountCurrentFrame(1);
-	case 2: Unexpected("Value 2 in VideoTrack::Shared::addTimelineDelay.");
-	case 3: return recountCurrentFrame(3);
-	case 4: Unexpected("Value 4 in VideoTrack::Shared::addTimelineDelay.");
-	case 5: return recountCurrentFrame(5);
-	case 6: Unexpected("Value 6 in VideoTrack::Shared::addTimelineDelay.");
-	case 7: return recountCurrentFrame(7);
+	const auto counterValue = counter();
+	if (counterValue < 0 || counterValue % 2 == 0) {
+		Unexpected("Counter value in VideoTrack::Shared::addTimelineDelay.");
 	}
-	Unexpected("Counter value in VideoTrack::Shared::addTimelineDelay.");
+	return recountCurrentFrame(counterValue);
 }
 
 bool VideoTrack::Shared::markFrameShown() {
@@ -1030,17 +1002,9 @@ bool VideoTrack::Shared::markFrameShown() {
 		return true;
 	};
 
-	switch (counter()) {
-	case 0: return false;
-	case 1: return jump(1);
-	case 2: return false;
-	case 3: return jump(3);
-	case 4: return false;
-	case 5: return jump(5);
-	case 6: return false;
-	case 7: return jump(7);
-	}
-	Unexpected("Counter value in VideoTrack::Shared::markFrameShown.");
+	const auto counterValue = counter();
+	Assert(counterValue >= 0 && counterValue < 2 * kFramesCount);
+	return (counterValue % 2 == 0) ? false : jump(counterValue);
 }
 
 not_null<VideoTrack::Frame*> VideoTrack::Shared::frameForPaint() {
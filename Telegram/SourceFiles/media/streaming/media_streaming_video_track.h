@@ -146,7 +146,9 @@ private:
 		static constexpr auto kCounterUninitialized = -1;
 		std::atomic<int> _counter = kCounterUninitialized;
 
-		static constexpr auto kFramesCount = 4;
+		// Deep enough for frame-threaded decoders to run several frames
+		// ahead of presentation (~80 ms at 60 fps), still latency-bounded.
+		static constexpr auto kFramesCount = 6;
 		std::array<Frame, kFramesCount> _frames;
 
 		// (_counter % 2) == 1 main thread can write _delay.
@@ -112,11 +112,39 @@ void OverlayWidget::RendererSW::paintTransformedStaticContent(
 		_p->fillRect(rect, _transparentBrush);
 	}
 	if (!image.isNull()) {
-		paintTransformedImage(image, rect, rotation);
+		paintTransformedImage(
+			downscaledStaticContent(image, rect, rotation),
+			rect,
+			rotation);
 	}
 	paintControlsFade(rect, geometry);
 }
 
+QImage OverlayWidget::RendererSW::downscaledStaticContent(
+		const QImage &image,
+		QRect rect,
+		int rotation) {
+	// Smooth-scaling the full-resolution photo on each repaint makes
+	// panning over huge panoramas cost proportionally to the source
+	// size, so scale to the shown size once and paint that copy 1:1.
+	const auto shown = ((rotation % 180) == 90)
+		? rect.size().transposed()
+		: rect.size();
+	const auto scaled = shown * style::DevicePixelRatio();
+	if (image.width() < scaled.width() * 2
+		|| image.height() < scaled.height() * 2) {
+		return image;
+	} else if (_downscaleCacheKey != image.cacheKey()
+		|| _downscaleCache.size() != scaled) {
+		_downscaleCacheKey = image.cacheKey();
+		_downscaleCache = image.scaled(
+			scaled,
+			Qt::IgnoreAspectRatio,
+			Qt::SmoothTransformation);
+	}
+	return _downscaleCache;
+}
+
 void OverlayWidget::RendererSW::paintControlsFade(
 		QRect content,
 		const ContentGeometry &geometry) {
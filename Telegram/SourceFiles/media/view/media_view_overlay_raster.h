@@ -33,6 +33,10 @@ private:
 		const QImage &image,
 		QRect rect,
 		int rotation);
+	[[nodiscard]] QImage downscaledStaticContent(
+		const QImage &image,
+		QRect rect,
+		int rotation);
 	void paintControlsFade(QRect content, const ContentGeometry &geometry);
 	void paintRadialLoading(
 		QRect inner,
@@ -76,6 +80,9 @@ private:
 	QImage _topShadowCache;
 	QColor _topShadowColor;
 
+	QImage _downscaleCache;
+	qint64 _downscaleCacheKey = 0;
+
 };
 
 } // namespace Media::View
@@ -124,6 +124,7 @@ bool ResolvingConnection::refreshChild() {
 		return false;
 	}
 	setChild(_child->clone(ToDirectIpProxy(_proxy, _ipIndex)));
+	_attemptStartedAt = crl::now();
 	_timeoutTimer.callOnce(kOneConnectionTimeout);
 	return true;
 }
@@ -138,6 +139,13 @@ void ResolvingConnection::handleError(int errorCode) {
 	if (_connected) {
 		emitError(errorCode);
 	} else if (!_proxy.resolvedIPs.empty()) {
+		if (_ipIndex >= 0 && _attemptStartedAt) {
+			CONNECTION_LOG_INFO(u"Resolving attempt %1 of %2 failed "
+				"in %3ms."_q
+				.arg(_ipIndex + 1)
+				.arg(_proxy.resolvedIPs.size())
+				.arg(crl::now() - _attemptStartedAt));
+		}
 		if (!refreshChild()) {
 			emitError(errorCode);
 		}
@@ -167,6 +175,13 @@ void ResolvingConnection::handleReceivedData() {
 void ResolvingConnection::handleConnected() {
 	_connected = true;
 	_timeoutTimer.cancel();
+	if (_ipIndex >= 0 && _attemptStartedAt) {
+		CONNECTION_LOG_INFO(u"Resolving attempt %1 of %2 connected "
+			"in %3ms."_q
+			.arg(_ipIndex + 1)
+			.arg(_proxy.resolvedIPs.size())
+			.arg(crl::now() - _attemptStartedAt));
+	}
 	if (_ipIndex >= 0) {
 		const auto host = _proxy.host;
 		const auto good = _proxy.resolvedIPs[_ipIndex];
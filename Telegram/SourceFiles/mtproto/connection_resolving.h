@@ -65,6 +65,7 @@ private:
 	int16 _protocolDcId = 0;
 	bool _protocolForFiles = false;
 	base::Timer _timeoutTimer;
+	crl::time _attemptStartedAt = 0;
 
 };
 
@@ -309,7 +309,8 @@ void TcpConnection::socketRead() {
 		const auto readCount = _socket->read(free.subspan(0, readLimit));
 		if (readCount > 0) {
 			const auto read = free.subspan(0, readCount);
-			aesCtrEncrypt(read, _receiveKey, &_receiveState);
+			Assert(_receiveCipher != nullptr);
+			_receiveCipher->process(read);
 			CONNECTION_LOG_INFO(u"Read %1 bytes"_q.arg(readCount));
 
 			_readBytes += readCount;
@@ -439,7 +440,8 @@ void TcpConnection::sendData(mtpBuffer &&buffer) {
 	const auto bytes = _protocol->finalizePacket(buffer);
 	CONNECTION_LOG_INFO(u"TCP Info: write packet %1 bytes."_q
 		.arg(bytes.size()));
-	aesCtrEncrypt(bytes, _sendKey, &_sendState);
+	Assert(_sendCipher != nullptr);
+	_sendCipher->process(bytes);
 	_socket->write(connectionStartPrefix, bytes);
 }
 
@@ -461,11 +463,12 @@ bytes::const_span TcpConnection::prepareConnectionStartPrefix(
 	} while (!_socket->isGoodStartNonce(nonce));
 
 	// prepare encryption key/iv
+	uchar sendKey[CTRState::KeySize];
 	_protocol->prepareKey(
-		bytes::make_span(_sendKey),
+		bytes::make_span(sendKey),
 		nonce.subspan(8, CTRState::KeySize));
-	bytes::copy(
-		bytes::make_span(_sendState.ivec),
+	_sendCipher = std::make_unique<CtrCipher>(
+		bytes::make_span(sendKey),
 		nonce.subspan(8 + CTRState::KeySize, CTRState::IvecSize));
 
 	// prepare decryption key/iv
@@ -473,11 +476,12 @@ bytes::const_span TcpConnection::prepareConnectionStartPrefix(
 	const auto reversed = bytes::make_span(reversedBytes);
 	bytes::copy(reversed, nonce.subspan(8, reversed.size()));
 	std::reverse(reversed.begin(), reversed.end());
+	uchar receiveKey[CTRState::KeySize];
 	_protocol->prepareKey(
-		bytes::make_span(_receiveKey),
+		bytes::make_span(receiveKey),
 		reversed.subspan(0, CTRState::KeySize));
-	bytes::copy(
-		bytes::make_span(_receiveState.ivec),
+	_receiveCipher = std::make_unique<CtrCipher>(
+		bytes::make_span(receiveKey),
 		reversed.subspan(CTRState::KeySize, CTRState::IvecSize));
 
 	// write protocol and dc ids
@@ -487,7 +491,7 @@ bytes::const_span TcpConnection::prepareConnectionStartPrefix(
 	*dcId = _protocolDcId;
 
 	bytes::copy(buffer, nonce.subspan(0, 56));
-	aesCtrEncrypt(nonce, _sendKey, &_sendState);
+	_sendCipher->process(nonce);
 	bytes::copy(buffer.subspan(56), nonce.subspan(56));
 
 	return buffer;
@@ -78,10 +78,8 @@ private:
 	bytes::vector _largeBuffer;
 	bool _usingLargeBuffer = false;
 
-	uchar _sendKey[CTRState::KeySize];
-	CTRState _sendState;
-	uchar _receiveKey[CTRState::KeySize];
-	CTRState _receiveState;
+	std::unique_ptr<CtrCipher> _sendCipher;
+	std::unique_ptr<CtrCipher> _receiveCipher;
 	class Protocol;
 	std::unique_ptr<Protocol> _protocol;
 	int16 _protocolDcId = 0;
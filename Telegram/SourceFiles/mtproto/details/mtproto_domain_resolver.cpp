@@ -245,7 +245,22 @@ void DomainResolver::checkExpireAndPushResult(const QString &domain) {
 	auto result = ipv4->second;
 	const auto ipv6 = _cache.find({ domain, true });
 	if (ipv6 != end(_cache) && ipv6->second.expireAt > _lastTimestamp) {
-		result.ips.append(ipv6->second.ips);
+		// Interleave the address families, so that a connect attempt
+		// walking this list in order switches the family after a single
+		// failure instead of timing out on every address of a broken one.
+		const auto &v6 = ipv6->second.ips;
+		auto mixed = QStringList();
+		mixed.reserve(result.ips.size() + v6.size());
+		const auto count = int(std::max(result.ips.size(), v6.size()));
+		for (auto i = 0; i != count; ++i) {
+			if (i < result.ips.size()) {
+				mixed.push_back(result.ips[i]);
+			}
+			if (i < v6.size()) {
+				mixed.push_back(v6[i]);
+			}
+		}
+		result.ips = std::move(mixed);
 		accumulate_min(result.expireAt, ipv6->second.expireAt);
 	}
 	InvokeQueued(this, [=] {
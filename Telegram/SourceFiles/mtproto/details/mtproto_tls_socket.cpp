@@ -887,27 +887,38 @@ void TlsSocket::write(bytes::const_span prefix, bytes::const_span buffer) {
 	if (!isConnected()) {
 		return;
 	}
+	// A large packet splits into hundreds of ~2878 byte parts with four
+	// writes each, so compose the whole framed packet in one buffer and
+	// hand it to the socket in a single write call.
+	const auto parts = (prefix.size() + buffer.size() + kClientPartSize - 1)
+		/ kClientPartSize;
+	auto packet = QByteArray();
+	packet.reserve(kClientPrefix.size()
+		+ parts * (kClientHeader.size() + int(sizeof(uint16)))
+		+ prefix.size()
+		+ buffer.size());
 	if (!prefix.empty()) {
-		_socket.write(kClientPrefix.data(), kClientPrefix.size());
+		packet.append(kClientPrefix.data(), kClientPrefix.size());
 	}
 	while (!buffer.empty()) {
 		const auto write = std::min(
 			kClientPartSize - prefix.size(),
 			buffer.size());
-		_socket.write(kClientHeader.data(), kClientHeader.size());
+		packet.append(kClientHeader.data(), kClientHeader.size());
 		const auto size = qToBigEndian(uint16(prefix.size() + write));
-		_socket.write(reinterpret_cast<const char*>(&size), sizeof(size));
+		packet.append(reinterpret_cast<const char*>(&size), sizeof(size));
 		if (!prefix.empty()) {
-			_socket.write(
+			packet.append(
 				reinterpret_cast<const char*>(prefix.data()),
 				prefix.size());
 			prefix = bytes::const_span();
 		}
-		_socket.write(
+		packet.append(
 			reinterpret_cast<const char*>(buffer.data()),
 			write);
 		buffer = buffer.subspan(write);
 	}
+	_socket.write(packet);
 }
 
 int32 TlsSocket::debugState() {
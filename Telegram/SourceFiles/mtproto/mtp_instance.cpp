@@ -50,6 +50,25 @@ int GetNextRequestId() {
 	return result;
 }
 
+namespace {
+
+std::atomic<int64> ContainersSentCount;
+std::atomic<int64> ContainedRequestsCount;
+std::atomic<int64> SingleRequestsCount;
+
+} // namespace
+
+void ReportContainerSent(int requests) {
+	ContainersSentCount.fetch_add(1, std::memory_order_relaxed);
+	ContainedRequestsCount.fetch_add(
+		requests,
+		std::memory_order_relaxed);
+}
+
+void ReportSingleSent() {
+	SingleRequestsCount.fetch_add(1, std::memory_order_relaxed);
+}
+
 } // namespace details
 
 class Instance::Private : private Sender {
@@ -1805,6 +1824,17 @@ void Instance::Private::prepareToDestroy() {
 	}
 }
 
+ContainerStats Instance::ContainerStatsSnapshot() {
+	using namespace details;
+	return {
+		.containers = ContainersSentCount.load(std::memory_order_relaxed),
+		.containedRequests = ContainedRequestsCount.load(
+			std::memory_order_relaxed),
+		.singleRequests = SingleRequestsCount.load(
+			std::memory_order_relaxed),
+	};
+}
+
 Instance::Instance(Mode mode, Fields &&fields)
 : QObject()
 , _private(std::make_unique<Private>(this, mode, std::move(fields))) {
@@ -18,8 +18,20 @@ class Session;
 
 [[nodiscard]] int GetNextRequestId();
 
+void ReportContainerSent(int requests);
+void ReportSingleSent();
+
 } // namespace details
 
+// Occupancy of outgoing msg_container-s: how many requests coalesced
+// into containers within one send tick versus went out alone. Filled
+// by the sessions on the MTProto thread, snapshot from anywhere.
+struct ContainerStats {
+	int64 containers = 0;
+	int64 containedRequests = 0;
+	int64 singleRequests = 0;
+};
+
 class DcOptions;
 class Config;
 struct ConfigFields;
@@ -56,6 +68,9 @@ public:
 	};
 
 	Instance(Mode mode, Fields &&fields);
+
+	[[nodiscard]] static ContainerStats ContainerStatsSnapshot();
+
 	Instance(const Instance &other) = delete;
 	Instance &operator=(const Instance &other) = delete;
 	~Instance();
@@ -10,6 +10,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/openssl_help.h"
 
 #include <QtCore/QDataStream>
+#include <openssl/evp.h>
 
 namespace MTP {
 
@@ -186,4 +187,36 @@ void aesCtrEncrypt(bytes::span data, const void *key, CTRState *state) {
 		(block128_f)AES_encrypt);
 }
 
+struct CtrCipher::Impl {
+	EVP_CIPHER_CTX *context = nullptr;
+};
+
+CtrCipher::CtrCipher(bytes::const_span key, bytes::const_span ivec)
+: _impl(std::make_unique<Impl>()) {
+	Expects(key.size() == CTRState::KeySize);
+	Expects(ivec.size() == CTRState::IvecSize);
+
+	_impl->context = EVP_CIPHER_CTX_new();
+	EVP_EncryptInit_ex(
+		_impl->context,
+		EVP_aes_256_ctr(),
+		nullptr,
+		reinterpret_cast<const uchar*>(key.data()),
+		reinterpret_cast<const uchar*>(ivec.data()));
+}
+
+CtrCipher::~CtrCipher() {
+	EVP_CIPHER_CTX_free(_impl->context);
+}
+
+void CtrCipher::process(bytes::span data) {
+	auto length = 0;
+	EVP_EncryptUpdate(
+		_impl->context,
+		reinterpret_cast<uchar*>(data.data()),
+		&length,
+		reinterpret_cast<const uchar*>(data.data()),
+		int(data.size()));
+}
+
 } // namespace MTP
@@ -122,4 +122,26 @@ struct CTRState {
 };
 void aesCtrEncrypt(bytes::span data, const void *key, CTRState *state);
 
+// Streaming AES-256-CTR with a cached key schedule. The plain
+// aesCtrEncrypt() helper re-expands the key on every call, which is
+// fine for one-shot buffers but wasteful on a transport that runs it
+// for every read and write of the connection; this one also goes
+// through EVP, so hardware AES is used when available.
+class CtrCipher final {
+public:
+	CtrCipher(bytes::const_span key, bytes::const_span ivec);
+	~CtrCipher();
+
+	CtrCipher(const CtrCipher &other) = delete;
+	CtrCipher &operator=(const CtrCipher &other) = delete;
+
+	// In-place, the counter state continues between calls.
+	void process(bytes::span data);
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> _impl;
+
+};
+
 } // namespace MTP
@@ -18,7 +18,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace MTP {
 namespace {
 
-constexpr auto kVersion = 2;
+constexpr auto kVersion = 3;
 
 using namespace details;
 
@@ -166,6 +166,7 @@ bool DcOptions::isTestMode() const {
 void DcOptions::constructFromBuiltIn() {
 	WriteLocker lock(this);
 	_data.clear();
+	_lastWorking.clear();
 
 	readBuiltInPublicKeys();
 
@@ -438,6 +439,12 @@ QByteArray DcOptions::serialize() const {
 		}
 	}
 
+	// Last working endpoints.
+	size += sizeof(qint32);
+	for (const auto &[dcId, endpoint] : _lastWorking) {
+		size += 4 * sizeof(qint32) + endpoint.ip.size();
+	}
+
 	auto result = QByteArray();
 	result.reserve(size);
 	{
@@ -471,6 +478,16 @@ QByteArray DcOptions::serialize() const {
 				<< Serialize::bytes(key.n)
 				<< Serialize::bytes(key.e);
 		}
+
+		// Last working endpoints.
+		stream << qint32(_lastWorking.size());
+		for (const auto &[dcId, endpoint] : _lastWorking) {
+			stream << qint32(dcId)
+				<< qint32(endpoint.port)
+				<< qint32(endpoint.protocol)
+				<< qint32(endpoint.ip.size());
+			stream.writeRawData(endpoint.ip.data(), endpoint.ip.size());
+		}
 	}
 	return result;
 }
@@ -566,6 +583,41 @@ bool DcOptions::constructFromSerialized(const QByteArray &serialized) {
 			}
 		}
 	}
+
+	// Read last working endpoints.
+	if (!stream.atEnd() && version > 2) {
+		auto count = qint32(0);
+		stream >> count;
+		if (stream.status() != QDataStream::Ok) {
+			LOG(("MTP Error: Bad last working endpoints count in "
+				"DcOptions::constructFromSerialized()"));
+			return false;
+		}
+		for (auto i = 0; i != count; ++i) {
+			qint32 dcId = 0, port = 0, protocol = 0, ipSize = 0;
+			stream >> dcId >> port >> protocol >> ipSize;
+
+			constexpr auto kMaxIpSize = 45;
+			if (ipSize <= 0 || ipSize > kMaxIpSize) {
+				LOG(("MTP Error: Bad last working endpoint inside "
+					"DcOptions::constructFromSerialized()"));
+				return false;
+			}
+			auto ip = std::string(ipSize, ' ');
+			stream.readRawData(ip.data(), ipSize);
+
+			if (stream.status() != QDataStream::Ok) {
+				LOG(("MTP Error: Bad last working endpoint inside "
+					"DcOptions::constructFromSerialized()"));
+				return false;
+			}
+			_lastWorking[DcId(dcId)] = LastWorking{
+				std::move(ip),
+				port,
+				protocol,
+			};
+		}
+	}
 	return true;
 }
 
@@ -595,6 +647,20 @@ std::vector<DcId> DcOptions::configEnumDcIds() const {
 	return result;
 }
 
+void DcOptions::setLastWorking(DcId dcId, LastWorking endpoint) {
+	WriteLocker lock(this);
+	_lastWorking[dcId] = std::move(endpoint);
+}
+
+std::optional<DcOptions::LastWorking> DcOptions::lastWorking(
+		DcId dcId) const {
+	ReadLocker lock(this);
+	const auto i = _lastWorking.find(dcId);
+	return (i != end(_lastWorking))
+		? std::make_optional(i->second)
+		: std::nullopt;
+}
+
 DcType DcOptions::dcType(ShiftedDcId shiftedDcId) const {
 	if (isTemporaryDcId(shiftedDcId)) {
 		return DcType::Temporary;
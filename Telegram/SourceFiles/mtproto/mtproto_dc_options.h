@@ -105,6 +105,17 @@ public:
 		bool throughProxy) const;
 	[[nodiscard]] DcType dcType(ShiftedDcId shiftedDcId) const;
 
+	// Last endpoint that reached connected state for a DC, tried with
+	// a priority boost on the next connect so a known-good address is
+	// adopted without waiting for the other racing variants.
+	struct LastWorking {
+		std::string ip;
+		int port = 0;
+		int protocol = 0; // Variants::Protocol value.
+	};
+	void setLastWorking(DcId dcId, LastWorking endpoint);
+	[[nodiscard]] std::optional<LastWorking> lastWorking(DcId dcId) const;
+
 	void setCDNConfig(const MTPDcdnConfig &config);
 	[[nodiscard]] bool hasCDNKeysForDc(DcId dcId) const;
 	[[nodiscard]] details::RSAPublicKey getDcRSAKey(
@@ -149,6 +160,7 @@ private:
 
 	const Environment _environment = Environment();
 	base::flat_map<DcId, std::vector<Endpoint>> _data;
+	base::flat_map<DcId, LastWorking> _lastWorking;
 	base::flat_set<DcId> _cdnDcIds;
 	base::flat_map<uint64, details::RSAPublicKey> _publicKeys;
 	base::flat_map<
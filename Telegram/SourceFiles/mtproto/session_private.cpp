@@ -189,9 +189,14 @@ void SessionPrivate::appendTestConnection(
 		const bytes::vector &protocolSecret) {
 	QWriteLocker lock(&_stateMutex);
 
+	const auto lastWorking = _lastWorkingEndpoint
+		&& (_lastWorkingEndpoint->ip == ip.toStdString())
+		&& (_lastWorkingEndpoint->port == port)
+		&& (_lastWorkingEndpoint->protocol == int(protocol));
 	const auto priority = (qthelp::is_ipv6(ip) ? 0 : 1)
 		+ (protocol == DcOptions::Variants::Tcp ? 1 : 0)
-		+ (protocolSecret.empty() ? 0 : 1);
+		+ (protocolSecret.empty() ? 0 : 1)
+		+ (lastWorking ? 4 : 0);
 	_testConnections.push_back({
 		AbstractConnection::Create(
 			_instance,
@@ -199,7 +204,10 @@ void SessionPrivate::appendTestConnection(
 			thread(),
 			protocolSecret,
 			_options->proxy),
-		priority
+		priority,
+		ip,
+		port,
+		int(protocol)
 	});
 	const auto weak = _testConnections.back().data.get();
 	connect(weak, &AbstractConnection::error, [=](int errorCode) {
@@ -741,6 +749,7 @@ void SessionPrivate::tryToSend() {
 			? bindDcKeyRequest
 			: toSend.begin()->second;
 		if (toSendCount == 1 && !first->forceSendInContainer) {
+			ReportSingleSent();
 			toSendRequest = first;
 			if (sendAll) {
 				toSend.clear();
@@ -832,6 +841,7 @@ void SessionPrivate::tryToSend() {
 				containerSize + 3 * toSend.size());
 			toSendRequest->push_back(mtpc_msg_container);
 			toSendRequest->push_back(toSendCount);
+			ReportContainerSent(toSendCount);
 
 			// check for a valid container
 			auto bigMsgId = base::unixtime::mtproto_msg_id();
@@ -990,6 +1000,8 @@ void SessionPrivate::connectToServer(bool afterConfig) {
 
 	const auto bareDc = BareDcId(_shiftedDcId);
 
+	_lastWorkingEndpoint = _instance->dcOptions().lastWorking(bareDc);
+
 	_currentDcType = tryAcquireKeyCreation();
 	if (_currentDcType == DcType::Cdn && !_instance->isKeysDestroyer()) {
 		if (!_instance->dcOptions().hasCDNKeysForDc(bareDc)) {
@@ -2291,6 +2303,7 @@ void SessionPrivate::onConnected(
 	} else {
 		DEBUG_LOG(("MTP Info: connection through IPv4 succeed."));
 		_waitForBetterTimer.cancel();
+		rememberWorkingEndpoint(*i);
 		_connection = std::move(i->data);
 		_testConnections.clear();
 		checkAuthKey();
@@ -2327,12 +2340,26 @@ void SessionPrivate::confirmBestConnection() {
 	DEBUG_LOG(("MTP Info: can't connect through better, using %1."
 		).arg(i->data->tag()));
 
+	rememberWorkingEndpoint(*i);
 	_connection = std::move(i->data);
 	_testConnections.clear();
 
 	checkAuthKey();
 }
 
+void SessionPrivate::rememberWorkingEndpoint(const TestConnection &test) {
+	// Proxied connections don't identify a good direct endpoint and
+	// the mtproto proxy path has no endpoint of its own here.
+	if (test.ip.isEmpty() || _options->proxy.type != ProxyData::Type::None) {
+		return;
+	}
+	_instance->dcOptions().setLastWorking(BareDcId(_shiftedDcId), {
+		test.ip.toStdString(),
+		test.port,
+		test.protocol,
+	});
+}
+
 void SessionPrivate::removeTestConnection(
 		not_null<AbstractConnection*> connection) {
 	_testConnections.erase(
@@ -56,6 +56,9 @@ private:
 	struct TestConnection {
 		ConnectionPointer data;
 		int priority = 0;
+		QString ip;
+		int port = 0;
+		int protocol = DcOptions::Variants::Tcp;
 	};
 	struct SentContainer {
 		crl::time sent = 0;
@@ -96,6 +99,7 @@ private:
 
 	void confirmBestConnection();
 	void removeTestConnection(not_null<AbstractConnection*> connection);
+	void rememberWorkingEndpoint(const TestConnection &test);
 	[[nodiscard]] int16 getProtocolDcId() const;
 
 	void checkSentRequests();
@@ -218,6 +222,7 @@ private:
 
 	std::shared_ptr<SessionData> _sessionData;
 	std::unique_ptr<SessionOptions> _options;
+	std::optional<DcOptions::LastWorking> _lastWorkingEndpoint;
 	AuthKeyPtr _encryptionKey;
 	uint64 _keyId = 0;
 	uint64 _sessionId = 0;
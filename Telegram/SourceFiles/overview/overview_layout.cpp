@@ -365,15 +365,15 @@ int32 Photo::resizeGetHeight(int32 width) {
 
 void Photo::paint(Painter &p, const QRect &clip, TextSelection selection, const PaintContext *context) {
 	const auto selected = (selection == FullSelection);
-	const auto widthChanged = _pix.width() != _width * cIntRetinaFactor();
-	if (!_goodLoaded || widthChanged) {
+	const auto widthChanged = (_pixWidth != _width);
+	const auto deferPrepare = context->quickScrolling && _pix.isNull();
+	if ((!_goodLoaded || widthChanged) && !deferPrepare) {
 		ensureDataMediaCreated();
 		const auto good = !_spoiler
 			&& (_dataMedia->loaded()
 				|| _dataMedia->image(Data::PhotoSize::Thumbnail));
 		if ((good && !_goodLoaded) || widthChanged) {
 			_goodLoaded = good;
-			_pix = QPixmap();
 			if (_goodLoaded) {
 				setPixFrom(_dataMedia->image(Data::PhotoSize::Large)
 					? _dataMedia->image(Data::PhotoSize::Large)
@@ -415,12 +415,27 @@ void Photo::paint(Painter &p, const QRect &clip, TextSelection selection, const
 void Photo::setPixFrom(not_null<Image*> image) {
 	Expects(_width > 0 && _height > 0);
 
-	auto img = image->original();
-	if (!_goodLoaded) {
-		img = Images::Blur(std::move(img));
-	}
-	_pix = Ui::PixmapFromImage(
-		CropMediaFrame(std::move(img), _width, _height));
+	// Blurring and cropping are too heavy for the paint, so prepare the
+	// pixmap on a background thread and repaint once it is ready, keeping
+	// the previous stage on screen meanwhile.
+	const auto goodLoaded = _goodLoaded;
+	const auto width = _width;
+	const auto height = _height;
+	_pixWidth = _width;
+	const auto weak = base::make_weak(this);
+	crl::async([=, img = image->original()]() mutable {
+		if (!goodLoaded) {
+			img = Images::Blur(std::move(img));
+		}
+		img = CropMediaFrame(std::move(img), width, height);
+		crl::on_main(weak, [=, img = std::move(img)]() mutable {
+			if (width != _width || height != _height) {
+				return;
+			}
+			_pix = Ui::PixmapFromImage(std::move(img));
+			delegate()->repaintItem(this);
+		});
+	});
 
 	// In case we have inline thumbnail we can unload all images and we still
 	// won't get a blank image in the media viewer when the photo is opened.
@@ -454,6 +469,10 @@ void Photo::clearHeavyPart() {
 	_dataMedia = nullptr;
 }
 
+void Photo::preloadHeavyPart() {
+	ensureDataMediaCreated();
+}
+
 TextState Photo::getState(
 		QPoint point,
 		StateRequest request) const {
@@ -514,17 +533,18 @@ void Video::paint(Painter &p, const QRect &clip, TextSelection selection, const
 	const auto radial = isRadialAnimation();
 	const auto radialOpacity = radial ? _radial->opacity() : 0.;
 
+	const auto deferPrepare = context->quickScrolling && _pix.isNull();
 	if ((blurred || thumbnail || good)
-		&& ((_pix.width() != _width * cIntRetinaFactor())
+		&& !deferPrepare
+		&& ((_pixWidth != _width)
 			|| (_pixBlurred && (thumbnail || good)))) {
-		auto img = good
+		_pixWidth = _width;
+		_pixBlurred = !(thumbnail || good);
+		preparePix(good
 			? good->original()
 			: thumbnail
 			? thumbnail->original()
-			: Images::Blur(blurred->original());
-		_pix = Ui::PixmapFromImage(
-			CropMediaFrame(std::move(img), _width, _height));
-		_pixBlurred = !(thumbnail || good);
+			: blurred->original(), _pixBlurred);
 	}
 
 	if (_pix.isNull()) {
@@ -601,6 +621,28 @@ void Video::paint(Painter &p, const QRect &clip, TextSelection selection, const
 	paintCheckbox(p, { checkLeft, checkTop }, selected, context);
 }
 
+void Video::preparePix(QImage image, bool blur) {
+	// Blurring and cropping are too heavy for the paint, so prepare the
+	// pixmap on a background thread and repaint once it is ready, keeping
+	// the previous stage on screen meanwhile.
+	const auto width = _width;
+	const auto height = _height;
+	const auto weak = base::make_weak(this);
+	crl::async([=, img = std::move(image)]() mutable {
+		if (blur) {
+			img = Images::Blur(std::move(img));
+		}
+		img = CropMediaFrame(std::move(img), width, height);
+		crl::on_main(weak, [=, img = std::move(img)]() mutable {
+			if (width != _width || height != _height) {
+				return;
+			}
+			_pix = Ui::PixmapFromImage(std::move(img));
+			delegate()->repaintItem(this);
+		});
+	});
+}
+
 void Video::ensureDataMediaCreated() const {
 	if (_dataMedia) {
 		return;
@@ -623,6 +665,10 @@ void Video::clearHeavyPart() {
 	_dataMedia = nullptr;
 }
 
+void Video::preloadHeavyPart() {
+	ensureDataMediaCreated();
+}
+
 float64 Video::dataProgress() const {
 	ensureDataMediaCreated();
 	return _dataMedia->progress();
@@ -1595,7 +1641,8 @@ Link::Link(
 		}
 		int32 afterLinkStart = entity.offset() + entity.length();
 		if (till > afterLinkStart) {
-			if (!QRegularExpression(u"^[,.\\s_=+\\-;:`'\"\\(\\)\\[\\]\\{\\}<>*&^%\\$#@!\\\\/]+$"_q).match(text.mid(afterLinkStart, till - afterLinkStart)).hasMatch()) {
+			static const auto expression = QRegularExpression(u"^[,.\\s_=+\\-;:`'\"\\(\\)\\[\\]\\{\\}<>*&^%\\$#@!\\\\/]+$"_q);
+			if (!expression.match(text.mid(afterLinkStart, till - afterLinkStart)).hasMatch()) {
 				++lnk;
 				break;
 			}
@@ -1603,7 +1650,8 @@ Link::Link(
 		till = entity.offset();
 	}
 	if (!lnk) {
-		if (QRegularExpression(u"^[,.\\s\\-;:`'\"\\(\\)\\[\\]\\{\\}<>*&^%\\$#@!\\\\/]+$"_q).match(text.mid(from, till - from)).hasMatch()) {
+		static const auto expression = QRegularExpression(u"^[,.\\s\\-;:`'\"\\(\\)\\[\\]\\{\\}<>*&^%\\$#@!\\\\/]+$"_q);
+		if (expression.match(text.mid(from, till - from)).hasMatch()) {
 			till = from;
 		}
 	}
@@ -46,6 +46,7 @@ public:
 	}
 	bool skipBorder = false;
 	bool paused = false;
+	bool quickScrolling = false;
 
 };
 
@@ -74,6 +75,10 @@ public:
 	virtual void clearHeavyPart() {
 	}
 
+	// Requests the thumbnail data early, before the first paint.
+	virtual void preloadHeavyPart() {
+	}
+
 protected:
 	[[nodiscard]] not_null<HistoryItem*> parent() const {
 		return _parent;
@@ -205,6 +210,7 @@ public:
 		StateRequest request) const override;
 
 	void clearHeavyPart() override;
+	void preloadHeavyPart() override;
 
 private:
 	void ensureDataMediaCreated() const;
@@ -217,6 +223,7 @@ private:
 	std::unique_ptr<Ui::SpoilerAnimation> _spoiler;
 
 	QPixmap _pix;
+	int _pixWidth = 0;
 	bool _goodLoaded = false;
 	bool _story = false;
 
@@ -298,6 +305,7 @@ public:
 
 	void clearHeavyPart() override;
 	void clearSpoiler() override;
+	void preloadHeavyPart() override;
 
 protected:
 	float64 dataProgress() const override;
@@ -307,6 +315,7 @@ protected:
 
 private:
 	void ensureDataMediaCreated() const;
+	void preparePix(QImage image, bool blur);
 	void updateStatusText();
 
 	const not_null<DocumentData*> _data;
@@ -317,6 +326,7 @@ private:
 	std::unique_ptr<Ui::SpoilerAnimation> _spoiler;
 
 	QPixmap _pix;
+	int _pixWidth = 0;
 	bool _pixBlurred = true;
 	bool _story = false;
 
@@ -1565,7 +1565,7 @@ void ShortcutMessages::sendInlineResult(
 			bots.resize(RecentInlineBotsLimit - 1);
 		}
 		bots.push_front(bot);
-		bot->session().local().writeRecentHashtagsAndBots();
+		bot->session().local().writeRecentHashtagsAndBotsDelayed();
 	}
 	finishSending();
 }
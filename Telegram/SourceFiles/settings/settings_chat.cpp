@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "settings/settings_chat.h"
 
+#include "kotato/kotato_lang.h"
 #include "settings/settings_advanced.h"
 #include "settings/settings_experimental.h"
 #include "boxes/abstract_box.h"
@@ -51,6 +52,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "info/downloads/info_downloads_widget.h"
 #include "info/info_memento.h"
 #include "storage/localstorage.h"
+#include "storage/storage_archive_import.h"
 #include "core/file_utilities.h"
 #include "core/application.h"
 #include "data/data_session.h"
@@ -1053,6 +1055,38 @@ void SetupExport(
 			[=] { Core::App().exportManager().start(session); });
 	});
 
+	AddButtonWithIcon(
+		container,
+		rktr("ktg_settings_import_archive"),
+		st::settingsButton,
+		{ &st::menuIconRestore }
+	)->addClickHandler([=] {
+		const auto session = &controller->session();
+		const auto parent = container.get();
+		FileDialog::GetOpenPath(
+			parent,
+			ktr("ktg_settings_import_archive"),
+			u"JSON files (*.json)"_q,
+			crl::guard(session, [=](FileDialog::OpenResult &&result) {
+				if (result.paths.isEmpty()) {
+					return;
+				}
+				Storage::ImportArchiveMedia(
+					session,
+					result.paths.front(),
+					crl::guard(session, [=](
+							Storage::ArchiveImportResult data) {
+						controller->showToast(data.failed
+							? ktr("ktg_import_archive_failed")
+							: ktr(
+								"ktg_import_archive_done",
+								{ "registered", QString::number(data.registered) },
+								{ "mismatched", QString::number(data.mismatched) },
+								{ "missing", QString::number(data.missing) }));
+					}));
+			}));
+	});
+
 	AddButtonWithIcon(
 		container,
 		tr::lng_settings_experimental(),
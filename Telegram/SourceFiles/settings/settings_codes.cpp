@@ -21,6 +21,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "lang/lang_cloud_manager.h"
 #include "lang/lang_instance.h"
 #include "core/application.h"
+#include "core/tracepoints.h"
 #include "mtproto/mtp_instance.h"
 #include "mtproto/mtproto_dc_options.h"
 #include "core/file_utilities.h"
@@ -86,6 +87,29 @@ auto GenerateCodes() {
 	codes.emplace(u"viewlogs"_q, [](SessionController *window) {
 		File::ShowInFolder(cWorkingDir() + "log.txt");
 	});
+	codes.emplace(u"tracemode"_q, [](SessionController *window) {
+		Trace::Toggle();
+		Ui::Toast::Show(Trace::Enabled()
+			? "Tracing enabled."
+			: "Tracing disabled.");
+	});
+	codes.emplace(u"savetrace"_q, [](SessionController *window) {
+		const auto path = Trace::SaveChromeTrace();
+		if (path.isEmpty()) {
+			Ui::Toast::Show("No trace events were recorded.");
+		} else {
+			File::ShowInFolder(path);
+		}
+	});
+	codes.emplace(u"scrollbench"_q, [](SessionController *window) {
+		if (!window) {
+			return;
+		}
+		const auto result = window->content()->runScrollBenchmark();
+		Ui::Toast::Show(result.isEmpty()
+			? u"Open a chat with some loaded history first."_q
+			: result);
+	});
 	if (!Core::UpdaterDisabled()) {
 		codes.emplace(u"testupdate"_q, [](SessionController *window) {
 			Core::UpdateChecker().test();
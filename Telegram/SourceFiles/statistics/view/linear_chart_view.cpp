@@ -35,14 +35,33 @@ void PaintChartLine(
 
 	const auto ratio = ratios.ratio(line.id);
 
-	for (auto i = localStart; i <= localEnd; i++) {
-		if (line.y[i] < 0) {
+	// Pick a downsampled tier so that the polyline stays at about two
+	// points per pixel however many indices are visible.
+	auto level = 0;
+	auto stride = 1;
+	{
+		const auto visible = (localEnd - localStart + 1);
+		const auto limit = std::max(c.rect.width() * 2, 1);
+		while (((visible / stride) > limit)
+			&& (level < int(line.downsampled.size()))) {
+			stride *= 2;
+			++level;
+		}
+	}
+	const auto value = [&](int i) {
+		return level ? line.downsampled[level - 1][i / stride] : line.y[i];
+	};
+
+	for (auto i = localStart - (localStart % stride)
+		; i <= localEnd
+		; i += stride) {
+		if (value(i) < 0) {
 			continue;
 		}
 		const auto xPoint = c.rect.width()
 			* ((c.chartData.xPercentage[i] - c.xPercentageLimits.min)
 				/ (c.xPercentageLimits.max - c.xPercentageLimits.min));
-		const auto yPercentage = (line.y[i] * ratio - c.heightLimits.min)
+		const auto yPercentage = (value(i) * ratio - c.heightLimits.min)
 			/ float64(c.heightLimits.max - c.heightLimits.min);
 		const auto yPoint = (1. - yPercentage) * c.rect.height();
 		chartPoints << QPointF(xPoint, yPoint);
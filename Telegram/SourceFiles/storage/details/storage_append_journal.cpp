@@ -0,0 +1,174 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "storage/details/storage_append_journal.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QDir>
+
+namespace Storage {
+namespace details {
+namespace {
+
+constexpr auto kJournalMagic = uint32(0x544A524E); // TJRN
+constexpr auto kJournalVersion = int32(1);
+constexpr auto kHeaderSize = int(sizeof(uint32) + sizeof(int32));
+constexpr auto kRecordHeaderSize = int(sizeof(int32));
+constexpr auto kMaxRecordSize = 64 * 1024 * 1024;
+
+} // namespace
+
+AppendJournal::AppendJournal(const QString &name, const QString &basePath)
+: _name(name)
+, _basePath(basePath) {
+}
+
+QString AppendJournal::filePath() const {
+	return _basePath + _name;
+}
+
+bool AppendJournal::writeHeader(QFile &file) {
+	auto header = QByteArray();
+	header.reserve(kHeaderSize);
+	{
+		QDataStream stream(&header, QIODevice::WriteOnly);
+		stream.setVersion(QDataStream::Qt_5_1);
+		stream << kJournalMagic << kJournalVersion;
+	}
+	return (file.write(header) == header.size());
+}
+
+bool AppendJournal::enumerate(
+		const MTP::AuthKeyPtr &key,
+		Fn<void(EncryptedDescriptor&)> record) {
+	_recordsCount = 0;
+
+	QFile file(filePath());
+	if (!file.open(QIODevice::ReadOnly)) {
+		return false;
+	}
+	const auto size = int64(file.size());
+	if (size < kHeaderSize) {
+		return false;
+	}
+	const auto mapped = file.map(0, size);
+	if (!mapped) {
+		return false;
+	}
+	const auto guard = gsl::finally([&] { file.unmap(mapped); });
+
+	auto from = reinterpret_cast<const char*>(mapped);
+	auto buffer = QBuffer();
+	auto bytes = QByteArray::fromRawData(from, size);
+	buffer.setBuffer(&bytes);
+	buffer.open(QIODevice::ReadOnly);
+	QDataStream stream(&buffer);
+	stream.setVersion(QDataStream::Qt_5_1);
+
+	auto magic = uint32();
+	auto version = int32();
+	stream >> magic >> version;
+	if (magic != kJournalMagic || version != kJournalVersion) {
+		return false;
+	}
+	auto offset = int64(kHeaderSize);
+	while (offset < size) {
+		if (size - offset < kRecordHeaderSize) {
+			LOG(("Journal Error: truncated record header in %1."
+				).arg(_name));
+			return (_recordsCount > 0);
+		}
+		auto encryptedSize = int32();
+		stream >> encryptedSize;
+		offset += kRecordHeaderSize;
+		if (encryptedSize <= 0
+			|| encryptedSize > kMaxRecordSize
+			|| size - offset < encryptedSize) {
+			LOG(("Journal Error: bad record size %1 in %2."
+				).arg(encryptedSize
+				).arg(_name));
+			return (_recordsCount > 0);
+		}
+		const auto encrypted = QByteArray::fromRawData(
+			from + offset,
+			encryptedSize);
+		stream.skipRawData(encryptedSize);
+		offset += encryptedSize;
+
+		auto data = EncryptedDescriptor();
+		if (!DecryptLocal(data, encrypted, key)) {
+			LOG(("Journal Error: could not decrypt record in %1."
+				).arg(_name));
+			return (_recordsCount > 0);
+		}
+		record(data);
+		++_recordsCount;
+	}
+	return (_recordsCount > 0);
+}
+
+void AppendJournal::append(
+		EncryptedDescriptor &data,
+		const MTP::AuthKeyPtr &key) {
+	QFile file(filePath());
+	const auto existed = file.exists() && (file.size() >= kHeaderSize);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+		LOG(("Journal Error: could not open %1 for append.").arg(_name));
+		return;
+	}
+	if (!existed) {
+		file.resize(0);
+		writeHeader(file);
+		_recordsCount = 0;
+	}
+	const auto encrypted = PrepareEncrypted(data, key);
+	auto header = QByteArray();
+	{
+		QDataStream stream(&header, QIODevice::WriteOnly);
+		stream.setVersion(QDataStream::Qt_5_1);
+		stream << int32(encrypted.size());
+	}
+	file.write(header);
+	file.write(encrypted);
+	file.flush();
+	++_recordsCount;
+}
+
+void AppendJournal::compact(
+		EncryptedDescriptor &full,
+		const MTP::AuthKeyPtr &key) {
+	const auto path = filePath();
+	const auto temp = path + u".tmp"_q;
+	{
+		QFile file(temp);
+		if (!file.open(QIODevice::WriteOnly)) {
+			LOG(("Journal Error: could not open %1 for compaction."
+				).arg(_name));
+			return;
+		}
+		writeHeader(file);
+		const auto encrypted = PrepareEncrypted(full, key);
+		auto header = QByteArray();
+		{
+			QDataStream stream(&header, QIODevice::WriteOnly);
+			stream.setVersion(QDataStream::Qt_5_1);
+			stream << int32(encrypted.size());
+		}
+		file.write(header);
+		file.write(encrypted);
+		file.flush();
+	}
+	QFile::remove(path);
+	if (!QFile::rename(temp, path)) {
+		LOG(("Journal Error: could not replace %1 after compaction."
+			).arg(_name));
+	}
+	_recordsCount = 1;
+}
+
+} // namespace details
+} // namespace Storage
@@ -0,0 +1,51 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "storage/details/storage_file_utilities.h"
+
+namespace Storage {
+namespace details {
+
+// Append-only container of encrypted records. A state change appends one
+// delta record instead of rewriting the whole blob, reads map the file and
+// decrypt records straight from the page cache. Callers replay records in
+// append order (first the base snapshot, then deltas) and call compact()
+// once the delta tail grows past their taste.
+class AppendJournal final {
+public:
+	AppendJournal(const QString &name, const QString &basePath);
+
+	// Maps the file and decrypts all records in append order.
+	// Returns false if the file is missing or fails consistency checks,
+	// a failed journal should be rewritten through compact().
+	[[nodiscard]] bool enumerate(
+		const MTP::AuthKeyPtr &key,
+		Fn<void(EncryptedDescriptor&)> record);
+
+	void append(EncryptedDescriptor &data, const MTP::AuthKeyPtr &key);
+
+	// Atomically replaces the journal with a single base record.
+	void compact(EncryptedDescriptor &full, const MTP::AuthKeyPtr &key);
+
+	[[nodiscard]] int recordsCount() const {
+		return _recordsCount;
+	}
+
+private:
+	[[nodiscard]] QString filePath() const;
+	bool writeHeader(QFile &file);
+
+	QString _name;
+	QString _basePath;
+	int _recordsCount = 0;
+
+};
+
+} // namespace details
+} // namespace Storage
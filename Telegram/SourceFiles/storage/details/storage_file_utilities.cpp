@@ -7,10 +7,12 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "storage/details/storage_file_utilities.h"
 
+#include "storage/details/storage_startup_prefetch.h"
 #include "mtproto/mtproto_auth_key.h"
 #include "base/platform/base_platform_file_utilities.h"
 #include "base/openssl_help.h"
 #include "base/random.h"
+#include "base/flat_map.h"
 
 #include <crl/crl_object_on_thread.h>
 #include <QtCore/QtEndian>
@@ -39,6 +41,7 @@ public:
 	void write(WriteEntry &&entry);
 	void writeSync(WriteEntry &&entry);
 	void writeSyncAll();
+	void forget(const QString &base);
 
 private:
 	void scheduleWrite();
@@ -57,12 +60,17 @@ private:
 	crl::weak_on_thread<WriteManager> _weak;
 	std::deque<WriteEntry> _scheduled;
 
+	// Md5 of the last data committed per file this session, so the
+	// shutdown flush can skip rewriting files that didn't change.
+	base::flat_map<QString, QByteArray> _committed;
+
 };
 
 class AsyncWriteManager final {
 public:
 	void write(WriteEntry &&entry);
 	void writeSync(WriteEntry &&entry);
+	void forget(const QString &base);
 	void sync();
 	void stop();
 
@@ -95,6 +103,13 @@ void WriteManager::writeSync(WriteEntry &&entry) {
 }
 
 void WriteManager::writeNow(WriteEntry &&entry) {
+	const auto committed = _committed.find(entry.base);
+	if (committed != end(_committed) && committed->second == entry.md5) {
+		// This exact content already reached the disk, most writes at
+		// quit are like that - don't stall shutdown rewriting them,
+		// especially on network drives.
+		return;
+	}
 	const auto path = [&](char postfix) {
 		return this->path(entry, postfix);
 	};
@@ -114,6 +129,7 @@ void WriteManager::writeNow(WriteEntry &&entry) {
 		if (save.commit()) {
 			QFile::remove(simple);
 			QFile::remove(backup);
+			_committed[entry.base] = entry.md5;
 			return;
 		}
 		LOG(("Storage Error: Could not commit '%1'.").arg(safe));
@@ -126,6 +142,7 @@ void WriteManager::writeNow(WriteEntry &&entry) {
 
 		QFile::remove(backup);
 		if (base::Platform::RenameWithOverwrite(simple, safe)) {
+			_committed[entry.base] = entry.md5;
 			return;
 		}
 		QFile::remove(safe);
@@ -133,6 +150,7 @@ void WriteManager::writeNow(WriteEntry &&entry) {
 			simple,
 			safe));
 	}
+	_committed.remove(entry.base);
 }
 
 void WriteManager::writeSyncAll() {
@@ -140,6 +158,10 @@ void WriteManager::writeSyncAll() {
 	}
 }
 
+void WriteManager::forget(const QString &base) {
+	_committed.remove(base);
+}
+
 bool WriteManager::writeOneScheduledNow() {
 	if (_scheduled.empty()) {
 		return false;
@@ -218,6 +240,14 @@ void AsyncWriteManager::writeSync(WriteEntry &&entry) {
 	});
 }
 
+void AsyncWriteManager::forget(const QString &base) {
+	if (_manager) {
+		_manager->with([base](WriteManager &manager) {
+			manager.forget(base);
+		});
+	}
+}
+
 void AsyncWriteManager::sync() {
 	if (_manager) {
 		_manager->with_sync([](WriteManager &manager) {
@@ -288,6 +318,10 @@ void ClearKey(const FileKey &key, const QString &basePath) {
 	QFile::remove(name);
 	name[name.size() - 1] = 's';
 	QFile::remove(name);
+	name.chop(1);
+	// The files are gone, the next write of this key must not be
+	// skipped as already committed even with the same content.
+	Manager.forget(name);
 }
 
 bool CheckStreamStatus(QDataStream &stream) {
@@ -577,6 +611,7 @@ bool ReadFile(
 			QFile::remove(toTry[1 - i]);
 		}
 
+		NotePrefetchedRead(fname);
 		return true;
 	}
 	return false;
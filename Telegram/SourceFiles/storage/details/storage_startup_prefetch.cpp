@@ -0,0 +1,131 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "storage/details/storage_startup_prefetch.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QMutex>
+
+namespace Storage {
+namespace details {
+namespace {
+
+// Startup reads are small settings / map / theme blobs, a larger file in
+// the manifest means the recording caught some unrelated read - skip it,
+// replaying it would evict more cache than it warms.
+constexpr auto kMaxManifestFiles = 64;
+constexpr auto kMaxPrefetchFileSize = qint64(16 * 1024 * 1024);
+constexpr auto kReadChunkSize = qint64(512 * 1024);
+
+const auto kManifestName = u"prefetch"_q;
+
+QMutex Mutex;
+bool Recording/* = false*/;
+std::vector<QString> Recorded;
+QString ManifestPath;
+
+[[nodiscard]] std::vector<QString> ReadManifest(const QString &path) {
+	QFile f(path);
+	if (!f.open(QIODevice::ReadOnly) || f.size() > 1024 * 1024) {
+		return {};
+	}
+	auto result = std::vector<QString>();
+	for (const auto &line : f.readAll().split('\n')) {
+		if (!line.isEmpty()) {
+			result.push_back(QString::fromUtf8(line));
+		}
+		if (result.size() >= kMaxManifestFiles) {
+			break;
+		}
+	}
+	return result;
+}
+
+void ReplaySequentially(const std::vector<QString> &paths) {
+	const auto started = crl::now();
+	auto chunk = QByteArray(kReadChunkSize, Qt::Uninitialized);
+	auto files = 0;
+	auto bytes = qint64(0);
+	for (const auto &path : paths) {
+		QFile f(path);
+		if (!f.open(QIODevice::ReadOnly)
+			|| f.size() > kMaxPrefetchFileSize) {
+			continue;
+		}
+		while (true) {
+			const auto read = f.read(chunk.data(), kReadChunkSize);
+			if (read <= 0) {
+				break;
+			}
+			bytes += read;
+		}
+		++files;
+	}
+	DEBUG_LOG(("Prefetch Info: replayed %1 files, %2 bytes, %3 ms."
+		).arg(files
+		).arg(bytes
+		).arg(crl::now() - started));
+}
+
+} // namespace
+
+void StartPrefetch(const QString &basePath) {
+	auto replay = std::vector<QString>();
+	{
+		QMutexLocker lock(&Mutex);
+		ManifestPath = basePath + kManifestName;
+		Recording = true;
+		Recorded.clear();
+		replay = ReadManifest(ManifestPath);
+	}
+	if (!replay.empty()) {
+		crl::async([replay = std::move(replay)] {
+			ReplaySequentially(replay);
+		});
+	}
+}
+
+void NotePrefetchedRead(const QString &path) {
+	QMutexLocker lock(&Mutex);
+	if (!Recording
+		|| Recorded.size() >= kMaxManifestFiles
+		|| ranges::contains(Recorded, path)) {
+		return;
+	}
+	Recorded.push_back(path);
+}
+
+void FinishPrefetchRecording() {
+	auto recorded = std::vector<QString>();
+	auto path = QString();
+	{
+		QMutexLocker lock(&Mutex);
+		if (!Recording) {
+			return;
+		}
+		Recording = false;
+		recorded = base::take(Recorded);
+		path = ManifestPath;
+	}
+	if (path.isEmpty()) {
+		return;
+	} else if (recorded.empty()) {
+		QFile::remove(path);
+		return;
+	}
+	auto content = QByteArray();
+	for (const auto &line : recorded) {
+		content.append(line.toUtf8()).append('\n');
+	}
+	QFile f(path);
+	if (f.open(QIODevice::WriteOnly)) {
+		f.write(content);
+	}
+}
+
+} // namespace details
+} // namespace Storage
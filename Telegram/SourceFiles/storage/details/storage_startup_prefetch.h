@@ -0,0 +1,27 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Storage {
+namespace details {
+
+// Classic boot prefetch. The list of files read through ReadFile during
+// the previous start is replayed with one sequential pass on a worker
+// thread before the demand reads arrive, so a cold start faults into a
+// warm page cache instead of paying a scattered disk seek per file.
+//
+// StartPrefetch() kicks off the replay and begins recording the current
+// start, FinishPrefetchRecording() writes the manifest for the next one.
+// Reads after the recording finished belong to normal operation and do
+// not grow the manifest.
+void StartPrefetch(const QString &basePath);
+void NotePrefetchedRead(const QString &path);
+void FinishPrefetchRecording();
+
+} // namespace details
+} // namespace Storage
@@ -32,6 +32,8 @@ constexpr auto kMaxTrackedSuccesses = kRetryAddSessionSuccesses
 constexpr auto kRemoveSessionAfterTimeouts = 4;
 constexpr auto kResetDownloadPrioritiesTimeout = crl::time(200);
 constexpr auto kBadRequestDurationThreshold = 8 * crl::time(1000);
+constexpr auto kPreconnectUsefulDuration = 30 * crl::time(1000);
+constexpr auto kCdnVerifyLogInterval = int64(64) * 1024 * 1024;
 
 // Each (session remove by timeouts) we wait for time:
 // kRetryAddSessionTimeout * max(removesCount, kMaxTrackedSessionRemoves)
@@ -82,7 +84,9 @@ bool DownloadManagerMtproto::Queue::empty() const {
 	return _tasks.empty();
 }
 
-auto DownloadManagerMtproto::Queue::nextTask(bool onlyHighestPriority) const
+auto DownloadManagerMtproto::Queue::nextTask(
+	bool onlyHighestPriority,
+	int *priority) const
 -> Task* {
 	if (_tasks.empty()) {
 		return nullptr;
@@ -100,7 +104,23 @@ auto DownloadManagerMtproto::Queue::nextTask(bool onlyHighestPriority) const
 	const auto first = ranges::find_if(
 		ranges::make_subrange(begin(_tasks), till),
 		readyToRequest);
-	return (first != till) ? first->task.get() : nullptr;
+	if (first == till) {
+		return nullptr;
+	}
+	if (priority) {
+		*priority = first->priority;
+	}
+	return first->task.get();
+}
+
+int DownloadManagerMtproto::Queue::highestWaitingPriority() const {
+	const auto readyToRequest = [&](const Enqueued &enqueued) {
+		return enqueued.task->readyToRequest();
+	};
+	const auto first = ranges::find_if(_tasks, readyToRequest);
+	return (first != end(_tasks))
+		? first->priority
+		: std::numeric_limits<int>::min();
 }
 
 void DownloadManagerMtproto::Queue::removeSession(int index) {
@@ -195,13 +215,52 @@ bool DownloadManagerMtproto::trySendNextPart(MTP::DcId dcId, Queue &queue) {
 		return false;
 	}
 	const auto onlyHighestPriority = (balanceData.totalRequested > 0);
-	if (const auto task = queue.nextTask(onlyHighestPriority)) {
+	auto priority = 0;
+	if (const auto task = queue.nextTask(onlyHighestPriority, &priority)) {
+		const auto index = static_cast<int>(
+			DownloadPriorityClassOf(priority));
+		++_classStats[index].sentParts;
+		_classStats[index].requestedBytes += kDownloadPartSize;
 		task->loadPart(bestIndex);
 		return true;
 	}
 	return false;
 }
 
+auto DownloadManagerMtproto::priorityClassStats(
+	DownloadPriorityClass priorityClass) const
+-> PriorityClassStats {
+	return _classStats[static_cast<int>(priorityClass)];
+}
+
+void DownloadManagerMtproto::preconnect(MTP::DcId dcId) {
+	if (!dcId) {
+		return;
+	}
+	const auto now = crl::now();
+	for (auto i = begin(_preconnected); i != end(_preconnected);) {
+		if (now - i->second > kPreconnectUsefulDuration) {
+			++_preconnectStats.misses;
+			i = _preconnected.erase(i);
+		} else {
+			++i;
+		}
+	}
+	const auto i = _preconnected.find(dcId);
+	if (i != end(_preconnected)) {
+		i->second = now;
+		return;
+	}
+	const auto j = _balanceData.find(dcId);
+	if (j != end(_balanceData) && j->second.totalRequested > 0) {
+		// A download from this DC is in flight, the session is warm.
+		return;
+	}
+	DEBUG_LOG(("Download Preconnect: warming up dc %1.").arg(dcId));
+	_preconnected.emplace(dcId, now);
+	api().instance().sendAnything(MTP::downloadDcId(dcId, 0));
+}
+
 int DownloadManagerMtproto::changeRequestedAmount(
 		MTP::DcId dcId,
 		int index,
@@ -219,6 +278,18 @@ int DownloadManagerMtproto::changeRequestedAmount(
 			&DcSessionBalanceData::requested);
 	};
 	if (delta > 0) {
+		if (const auto j = _preconnected.find(dcId)
+			; j != end(_preconnected)) {
+			const auto warm = (crl::now() - j->second
+				<= kPreconnectUsefulDuration);
+			++(warm ? _preconnectStats.hits : _preconnectStats.misses);
+			DEBUG_LOG(("Download Preconnect: dc %1 %2 (hits %3, misses %4)."
+				).arg(dcId
+				).arg(warm ? u"hit"_q : u"miss"_q
+				).arg(_preconnectStats.hits
+				).arg(_preconnectStats.misses));
+			_preconnected.erase(j);
+		}
 		killSessionsCancel(dcId);
 	} else if (findNonEmptySession(i->second) == end(i->second.sessions)) {
 		killSessionsSchedule(dcId);
@@ -259,7 +330,17 @@ void DownloadManagerMtproto::requestSucceeded(
 		});
 		return;
 	}
-	if (amountAtRequestStart == data.maxWaitedAmount
+	const auto visibleWaiting = [&] {
+		const auto j = _queues.find(dcId);
+		return (j != end(_queues))
+			&& (DownloadPriorityClassOf(j->second.highestWaitingPriority())
+				== DownloadPriorityClass::Visible);
+	}();
+	if (visibleWaiting) {
+		// Keep session windows from widening for a long background
+		// download while parts for visible media wait in the queue,
+		// freed slots should go to them instead.
+	} else if (amountAtRequestStart == data.maxWaitedAmount
 		&& data.maxWaitedAmount < kMaxWaitedInSession) {
 		data.maxWaitedAmount = std::min(
 			data.maxWaitedAmount + kDownloadPartSize,
@@ -682,53 +763,104 @@ void DownloadMtprotoTask::cdnPartLoaded(const MTPupload_CdnFile &result, mtpRequ
 			owner->checkSendNextAfterSuccess(dcId);
 		});
 
-		auto key = bytes::make_span(_cdnEncryptionKey);
-		auto iv = bytes::make_span(_cdnEncryptionIV);
-		Expects(key.size() == MTP::CTRState::KeySize);
-		Expects(iv.size() == MTP::CTRState::IvecSize);
-
-		auto state = MTP::CTRState();
-		auto ivec = bytes::make_span(state.ivec);
-		std::copy(iv.begin(), iv.end(), ivec.begin());
-
-		auto counterOffset = static_cast<uint32>(requestData.offset >> 4);
-		state.ivec[15] = static_cast<uchar>(counterOffset & 0xFF);
-		state.ivec[14] = static_cast<uchar>((counterOffset >> 8) & 0xFF);
-		state.ivec[13] = static_cast<uchar>((counterOffset >> 16) & 0xFF);
-		state.ivec[12] = static_cast<uchar>((counterOffset >> 24) & 0xFF);
-
-		auto decryptInPlace = data.vbytes().v;
-		auto buffer = bytes::make_detached_span(decryptInPlace);
-		MTP::aesCtrEncrypt(buffer, key.data(), &state);
-
-		switch (checkCdnFileHash(requestData.offset, buffer)) {
-		case CheckCdnHashResult::NoHash: {
-			_cdnUncheckedParts.emplace(requestData, decryptInPlace);
-			requestMoreCdnFileHashes();
-		} return;
+		Expects(_cdnEncryptionKey.size() == MTP::CTRState::KeySize);
+		Expects(_cdnEncryptionIV.size() == MTP::CTRState::IvecSize);
+
+		// Decrypting and hashing a part is heavy enough to stall the main
+		// thread, so do it on a separate one - verification of this part
+		// overlaps with the following parts being downloaded. OpenSSL
+		// dispatches to the hardware SHA instructions where available.
+		const auto weak = base::make_weak(this);
+		crl::async([
+			=,
+			bytes = data.vbytes().v,
+			key = _cdnEncryptionKey,
+			iv = _cdnEncryptionIV
+		]() mutable {
+			const auto start = crl::now();
+
+			auto state = MTP::CTRState();
+			auto ivec = bytes::make_span(state.ivec);
+			const auto ivBytes = bytes::make_span(iv);
+			std::copy(ivBytes.begin(), ivBytes.end(), ivec.begin());
+
+			auto counterOffset = static_cast<uint32>(requestData.offset >> 4);
+			state.ivec[15] = static_cast<uchar>(counterOffset & 0xFF);
+			state.ivec[14] = static_cast<uchar>((counterOffset >> 8) & 0xFF);
+			state.ivec[13] = static_cast<uchar>((counterOffset >> 16) & 0xFF);
+			state.ivec[12] = static_cast<uchar>((counterOffset >> 24) & 0xFF);
+
+			auto buffer = bytes::make_detached_span(bytes);
+			MTP::aesCtrEncrypt(buffer, bytes::make_span(key).data(), &state);
+			auto hash = openssl::Sha256(buffer);
+
+			const auto elapsed = crl::now() - start;
+			crl::on_main(weak, [
+				=,
+				bytes = std::move(bytes),
+				hash = std::move(hash)
+			]() mutable {
+				cdnPartDecrypted(
+					requestData,
+					std::move(bytes),
+					hash,
+					elapsed);
+			});
+		});
+	});
+}
 
-		case CheckCdnHashResult::Invalid: {
-			LOG(("API Error: Wrong cdnFileHash for offset %1."
-				).arg(requestData.offset));
-			cancelOnFail();
-		} return;
+void DownloadMtprotoTask::cdnPartDecrypted(
+		const RequestData &requestData,
+		QByteArray &&bytes,
+		const bytes::vector &hash,
+		crl::time elapsed) {
+	_cdnVerifiedBytes += bytes.size();
+	_cdnVerifyTime += elapsed;
+	if (_cdnVerifiedBytes >= kCdnVerifyLogInterval) {
+		DEBUG_LOG(("Download CDN: verified %1 MB at %2 KB/s."
+			).arg(_cdnVerifiedBytes / (1024 * 1024)
+			).arg(_cdnVerifiedBytes
+				/ std::max(_cdnVerifyTime, crl::time(1))));
+		_cdnVerifiedBytes = 0;
+		_cdnVerifyTime = 0;
+	}
+	switch (checkCdnFileHashValue(requestData.offset, hash)) {
+	case CheckCdnHashResult::NoHash: {
+		_cdnUncheckedParts.emplace(requestData, std::move(bytes));
+		requestMoreCdnFileHashes();
+	} return;
+
+	case CheckCdnHashResult::Invalid: {
+		LOG(("API Error: Wrong cdnFileHash for offset %1."
+			).arg(requestData.offset));
+		cancelOnFail();
+	} return;
 
-		case CheckCdnHashResult::Good: {
-			partLoaded(requestData.offset, decryptInPlace);
-		} return;
-		}
-		Unexpected("Result of checkCdnFileHash()");
-	});
+	case CheckCdnHashResult::Good: {
+		partLoaded(requestData.offset, bytes);
+	} return;
+	}
+	Unexpected("Result of checkCdnFileHashValue()");
 }
 
 DownloadMtprotoTask::CheckCdnHashResult DownloadMtprotoTask::checkCdnFileHash(
 		int64 offset,
 		bytes::const_span buffer) {
+	if (_cdnFileHashes.find(offset) == _cdnFileHashes.cend()) {
+		return CheckCdnHashResult::NoHash;
+	}
+	return checkCdnFileHashValue(offset, openssl::Sha256(buffer));
+}
+
+auto DownloadMtprotoTask::checkCdnFileHashValue(
+	int64 offset,
+	bytes::const_span realHash)
+-> CheckCdnHashResult {
 	const auto cdnFileHashIt = _cdnFileHashes.find(offset);
 	if (cdnFileHashIt == _cdnFileHashes.cend()) {
 		return CheckCdnHashResult::NoHash;
 	}
-	const auto realHash = openssl::Sha256(buffer);
 	const auto receivedHash = bytes::make_span(cdnFileHashIt->second.hash);
 	if (bytes::compare(realHash, receivedHash)) {
 		return CheckCdnHashResult::Invalid;
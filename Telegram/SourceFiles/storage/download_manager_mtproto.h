@@ -27,6 +27,25 @@ constexpr auto kDownloadPartSize = 128 * 1024;
 
 class DownloadMtprotoTask;
 
+// Explicit priority classes over the integer priorities: parts for media
+// on screen beat speculative preloads, which beat background downloads.
+enum class DownloadPriorityClass {
+	Background,
+	Preload,
+	Visible,
+};
+
+constexpr auto kVisibleDownloadPriority = 2;
+
+[[nodiscard]] inline DownloadPriorityClass DownloadPriorityClassOf(
+		int priority) {
+	return (priority >= kVisibleDownloadPriority)
+		? DownloadPriorityClass::Visible
+		: (priority > 0)
+		? DownloadPriorityClass::Preload
+		: DownloadPriorityClass::Background;
+}
+
 class DownloadManagerMtproto final : public base::has_weak_ptr {
 public:
 	using Task = DownloadMtprotoTask;
@@ -48,6 +67,26 @@ public:
 		return _taskFinished.events();
 	}
 
+	struct PriorityClassStats {
+		int64 sentParts = 0;
+		int64 requestedBytes = 0;
+	};
+	[[nodiscard]] PriorityClassStats priorityClassStats(
+		DownloadPriorityClass priorityClass) const;
+
+	// Warms up the download session for a DC before the first part is
+	// requested, so that opening a media-heavy chat doesn't pay for the
+	// transport connect and auth key setup on the first download.
+	void preconnect(MTP::DcId dcId);
+
+	struct PreconnectStats {
+		int hits = 0;
+		int misses = 0;
+	};
+	[[nodiscard]] PreconnectStats preconnectStats() const {
+		return _preconnectStats;
+	}
+
 	int changeRequestedAmount(MTP::DcId dcId, int index, int delta);
 	void requestSucceeded(
 		MTP::DcId dcId,
@@ -64,7 +103,10 @@ private:
 		void remove(not_null<Task*> task);
 		void resetGeneration();
 		[[nodiscard]] bool empty() const;
-		[[nodiscard]] Task *nextTask(bool onlyHighestPriority) const;
+		[[nodiscard]] Task *nextTask(
+			bool onlyHighestPriority,
+			int *priority = nullptr) const;
+		[[nodiscard]] int highestWaitingPriority() const;
 		void removeSession(int index);
 
 	private:
@@ -117,6 +159,9 @@ private:
 	base::Timer _killSessionsTimer;
 
 	base::flat_map<MTP::DcId, Queue> _queues;
+	std::array<PriorityClassStats, 3> _classStats;
+	base::flat_map<MTP::DcId, crl::time> _preconnected;
+	PreconnectStats _preconnectStats;
 	rpl::lifetime _lifetime;
 
 };
@@ -213,6 +258,11 @@ private:
 	void cdnPartLoaded(
 		const MTPupload_CdnFile &result,
 		mtpRequestId requestId);
+	void cdnPartDecrypted(
+		const RequestData &requestData,
+		QByteArray &&bytes,
+		const bytes::vector &hash,
+		crl::time elapsed);
 	void reuploadDone(
 		const MTPVector<MTPFileHash> &result,
 		mtpRequestId requestId);
@@ -252,6 +302,9 @@ private:
 	[[nodiscard]] CheckCdnHashResult checkCdnFileHash(
 		int64 offset,
 		bytes::const_span buffer);
+	[[nodiscard]] CheckCdnHashResult checkCdnFileHashValue(
+		int64 offset,
+		bytes::const_span realHash);
 
 	const not_null<DownloadManagerMtproto*> _owner;
 	const MTP::DcId _dcId = 0;
@@ -270,6 +323,8 @@ private:
 	base::flat_map<int64, CdnFileHash> _cdnFileHashes;
 	base::flat_map<RequestData, QByteArray> _cdnUncheckedParts;
 	mtpRequestId _cdnHashesRequestId = 0;
+	int64 _cdnVerifiedBytes = 0;
+	crl::time _cdnVerifyTime = 0;
 
 };
 
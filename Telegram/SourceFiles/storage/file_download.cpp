@@ -25,6 +25,13 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace {
 
+// A sidecar journal next to big file-destination downloads records the
+// contiguous verified prefix, so an interrupted download resumes from
+// there instead of starting over.
+constexpr auto kJournalMagic = qint32(0x314C4A44); // "DJL1"
+constexpr auto kJournalMinFileSize = 8 * int64(1024) * 1024;
+constexpr auto kJournalFlushEach = 8 * int64(1024) * 1024;
+
 class FromMemoryLoader final : public FileLoader {
 public:
 	FromMemoryLoader(
@@ -146,6 +153,36 @@ void FileLoader::finishWithBytes(const QByteArray &data) {
 			QFileInfo(_file).absoluteFilePath());
 	}
 	const auto session = _session;
+	if (_locationType == UnknownFileLocation
+		&& _imageData.isNull()
+		&& !_data.isEmpty()) {
+		// Pre-decode the image on the background thread pool, so that
+		// the done handlers calling imageData() don't block the main
+		// thread on an expensive JPEG / WebP decode. The local cache
+		// read path in loadLocal() already decodes asynchronously.
+		crl::async([guard = base::make_weak(this), data = _data] {
+			auto read = Images::Read({ .content = data });
+			crl::on_main(guard, [
+				guard,
+				image = std::move(read.image),
+				format = std::move(read.format)
+			]() mutable {
+				const auto that = guard.get();
+				if (that->_cancelled) {
+					return;
+				}
+				if (!image.isNull()) {
+					that->_imageData = std::move(image);
+					that->_imageFormat = std::move(format);
+				}
+				// A done handler may destroy the loader.
+				const auto session = that->_session;
+				that->_updates.fire_done();
+				session->notifyDownloaderTaskFinished();
+			});
+		});
+		return;
+	}
 	_updates.fire_done();
 	session->notifyDownloaderTaskFinished();
 }
@@ -244,7 +281,11 @@ void FileLoader::start() {
 	}
 
 	if (checkForOpen()) {
-		startLoading();
+		if (const auto resumeOffset = base::take(_resumeOffset)) {
+			startLoadingResumed(resumeOffset);
+		} else {
+			startLoading();
+		}
 	}
 }
 
@@ -254,6 +295,16 @@ bool FileLoader::checkForOpen() {
 		|| _fileIsOpen) {
 		return true;
 	}
+	if (const auto verified = readJournal()) {
+		_fileIsOpen = _file.open(QIODevice::ReadWrite);
+		if (_fileIsOpen && _file.resize(verified)) {
+			_verifiedTill = _journaledTill = _resumeOffset = verified;
+			return true;
+		} else if (_fileIsOpen) {
+			_file.close();
+			_fileIsOpen = false;
+		}
+	}
 	_fileIsOpen = _file.open(QIODevice::WriteOnly);
 	if (_fileIsOpen) {
 		return true;
@@ -262,6 +313,88 @@ bool FileLoader::checkForOpen() {
 	return false;
 }
 
+bool FileLoader::journalEnabled() const {
+	return (_toCache == LoadToFileOnly)
+		&& !_filename.isEmpty()
+		&& (_fullSize >= kJournalMinFileSize);
+}
+
+QString FileLoader::journalPath() const {
+	return _filename + u".journal"_q;
+}
+
+int64 FileLoader::readJournal() const {
+	if (!journalEnabled() || !_file.exists()) {
+		return 0;
+	}
+	auto journal = QFile(journalPath());
+	if (!journal.open(QIODevice::ReadOnly)) {
+		return 0;
+	}
+	auto stream = QDataStream(&journal);
+	stream.setVersion(QDataStream::Qt_5_1);
+	auto magic = qint32(0);
+	auto fullSize = qint64(0);
+	auto verified = qint64(0);
+	stream >> magic >> fullSize >> verified;
+	if (stream.status() != QDataStream::Ok
+		|| magic != kJournalMagic
+		|| fullSize != _fullSize
+		|| verified <= 0
+		|| verified >= _loadSize) {
+		return 0;
+	}
+	// Trust only whole parts and never past the data actually on disk.
+	verified -= (verified % Storage::kDownloadPartSize);
+	return std::min(int64(verified), int64(_file.size()));
+}
+
+void FileLoader::journalPartWritten(int64 offset, int64 size) {
+	if (!journalEnabled()) {
+		return;
+	}
+	if (offset <= _verifiedTill) {
+		_verifiedTill = std::max(_verifiedTill, offset + size);
+		while (!_journalPending.empty()) {
+			const auto i = _journalPending.begin();
+			if (i->first > _verifiedTill) {
+				break;
+			}
+			_verifiedTill = std::max(_verifiedTill, i->second);
+			_journalPending.erase(i);
+		}
+		if (_verifiedTill - _journaledTill >= kJournalFlushEach) {
+			writeJournal();
+		}
+	} else {
+		// Parts may finish out of order, remember the range till the
+		// hole before it is filled.
+		auto &till = _journalPending[offset];
+		till = std::max(till, offset + size);
+	}
+}
+
+void FileLoader::writeJournal() {
+	// The journal must never claim more than what reached the disk.
+	_file.flush();
+
+	auto journal = QFile(journalPath());
+	if (!journal.open(QIODevice::WriteOnly)) {
+		return;
+	}
+	auto stream = QDataStream(&journal);
+	stream.setVersion(QDataStream::Qt_5_1);
+	stream << kJournalMagic << qint64(_fullSize) << qint64(_verifiedTill);
+	journal.close();
+	_journaledTill = _verifiedTill;
+}
+
+void FileLoader::removeJournal() {
+	if ((_toCache == LoadToFileOnly) && !_filename.isEmpty()) {
+		QFile::remove(journalPath());
+	}
+}
+
 void FileLoader::loadLocal(const Storage::Cache::Key &key) {
 	const auto readImage = (_locationType != AudioFileLocation);
 	auto done = [=, guard = _localLoading.make_guard()](
@@ -344,6 +477,7 @@ void FileLoader::cancel(FailureReason fail) {
 		_fileIsOpen = false;
 		_file.remove();
 	}
+	removeJournal();
 	_data = QByteArray();
 
 	const auto weak = base::make_weak(this);
@@ -380,6 +514,7 @@ bool FileLoader::writeResultPart(int64 offset, bytes::const_span buffer) {
 			cancel(FailureReason::FileWriteFailure);
 			return false;
 		}
+		journalPartWritten(offset, buffer.size());
 		return true;
 	}
 	_data.reserve(offset + buffer.size());
@@ -446,6 +581,7 @@ bool FileLoader::finalizeResult() {
 		Platform::File::PostprocessDownloaded(
 			QFileInfo(_file).absoluteFilePath());
 	}
+	removeJournal();
 	if (_localStatus == LocalStatus::NotFound) {
 		if (const auto key = fileLocationKey()) {
 			if (!_filename.isEmpty()) {
@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #pragma once
 
 #include "base/binary_guard.h"
+#include "base/flat_map.h"
 #include "base/weak_ptr.h"
 
 #include <QtNetwork/QNetworkReply>
@@ -152,6 +153,11 @@ protected:
 	virtual void startLoadingWithPartial(const QByteArray &data) {
 		startLoading();
 	}
+	virtual void startLoadingResumed(int64 offset) {
+		_file.resize(0);
+		_verifiedTill = 0;
+		startLoading();
+	}
 
 	void cancel(FailureReason failed);
 
@@ -161,6 +167,13 @@ protected:
 	bool finalizeResult();
 	[[nodiscard]] QByteArray readLoadedPartBack(int64 offset, int size);
 
+	[[nodiscard]] bool journalEnabled() const;
+	[[nodiscard]] QString journalPath() const;
+	[[nodiscard]] int64 readJournal() const;
+	void journalPartWritten(int64 offset, int64 size);
+	void writeJournal();
+	void removeJournal();
+
 	const not_null<Main::Session*> _session;
 
 	bool _autoLoading = false;
@@ -181,6 +194,10 @@ protected:
 	int64 _loadSize = 0;
 	int64 _fullSize = 0;
 	int64 _skippedBytes = 0;
+	int64 _verifiedTill = 0;
+	int64 _journaledTill = 0;
+	int64 _resumeOffset = 0;
+	base::flat_map<int64, int64> _journalPending;
 	LocationType _locationType = LocationType();
 
 	base::binary_guard _localLoading;
@@ -197,6 +197,12 @@ void mtpFileLoader::startLoadingWithPartial(const QByteArray &data) {
 	startLoading();
 }
 
+void mtpFileLoader::startLoadingResumed(int64 offset) {
+	// The journaled prefix is already on disk, just request what follows.
+	_nextRequestOffset = offset;
+	startLoading();
+}
+
 void mtpFileLoader::cancelHook() {
 	cancelAllRequests();
 }
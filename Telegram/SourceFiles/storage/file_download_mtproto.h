@@ -60,6 +60,7 @@ private:
 	std::optional<MediaKey> fileLocationKey() const override;
 	void startLoading() override;
 	void startLoadingWithPartial(const QByteArray &data) override;
+	void startLoadingResumed(int64 offset) override;
 	void cancelHook() override;
 
 	bool readyToRequest() const override;
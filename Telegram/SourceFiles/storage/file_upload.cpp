@@ -630,7 +630,15 @@ void Uploader::sendNext() {
 
 		parts.erase(part);
 	}
-	_nextTimer.callOnce(crl::time(UploadSessionsInterval()));
+	// Fill the whole in-flight window right away instead of growing it
+	// by a single part per interval, so a fresh upload ramps up to the
+	// full parallel budget immediately. The interval only paces the
+	// steady state when the window is already full.
+	const auto windowFull = (sentSize
+		>= (UploadSessionsCount() * 512 * 1024));
+	_nextTimer.callOnce(windowFull
+		? crl::time(UploadSessionsInterval())
+		: crl::time(0));
 }
 
 void Uploader::cancel(const FullMsgId &msgId) {
@@ -258,7 +258,8 @@ SendMediaReady::SendMediaReady(
 	}
 }
 
-TaskQueue::TaskQueue(crl::time stopTimeoutMs) {
+TaskQueue::TaskQueue(crl::time stopTimeoutMs, QThread::Priority priority)
+: _priority(priority) {
 	if (stopTimeoutMs > 0) {
 		_stopTimer = new QTimer(this);
 		connect(_stopTimer, SIGNAL(timeout()), this, SLOT(stop()));
@@ -300,12 +301,17 @@ void TaskQueue::wakeThread() {
 		connect(this, SIGNAL(taskAdded()), _worker, SLOT(onTaskAdded()));
 		connect(_worker, SIGNAL(taskProcessed()), this, SLOT(onTaskProcessed()));
 
-		_thread->start();
+		_thread->start(_priority);
 	}
 	if (_stopTimer) _stopTimer->stop();
 	taskAdded();
 }
 
+int TaskQueue::queueDepth() {
+	QMutexLocker lock(&_tasksToProcessMutex);
+	return int(_tasksToProcess.size()) + (_taskInProcessId ? 1 : 0);
+}
+
 void TaskQueue::cancelTask(TaskId id) {
 	const auto removeFrom = [&](std::deque<std::unique_ptr<Task>> &queue) {
 		const auto proj = [](const std::unique_ptr<Task> &task) {
@@ -645,9 +651,10 @@ bool FileLoadTask::CheckForVideo(
 		return false;
 	}
 
-	auto coverWidth = media.thumbnail.width();
-	auto coverHeight = media.thumbnail.height();
-	if (!ValidateThumbDimensions(coverWidth, coverHeight)) {
+	const auto dimensions = media.dimensions.isEmpty()
+		? media.thumbnail.size()
+		: media.dimensions;
+	if (!ValidateThumbDimensions(dimensions.width(), dimensions.height())) {
 		return false;
 	}
 
@@ -860,8 +867,11 @@ void FileLoadTask::process(Args &&args) {
 		} else if (auto video = std::get_if<Ui::PreparedFileInformation::Video>(
 				&_information->media)) {
 			isVideo = true;
-			auto coverWidth = video->thumbnail.width();
-			auto coverHeight = video->thumbnail.height();
+			const auto dimensions = video->dimensions.isEmpty()
+				? video->thumbnail.size()
+				: video->dimensions;
+			auto coverWidth = dimensions.width();
+			auto coverHeight = dimensions.height();
 			if (video->isGifv && !_album) {
 				attributes.push_back(MTP_documentAttributeAnimated());
 			}
@@ -928,14 +938,18 @@ void FileLoadTask::process(Args &&args) {
 				if (Core::IsMimeSticker(filemime)) {
 					fullimage = Images::Opaque(std::move(fullimage));
 				}
-				auto medium = (w > 320 || h > 320) ? fullimage.scaled(320, 320, Qt::KeepAspectRatio, Qt::SmoothTransformation) : fullimage;
-
 				const auto limit = PhotoSideLimitAtomic();
 				const auto downscaled = (w > limit || h > limit);
 				auto full = downscaled ? fullimage.scaled(limit, limit, Qt::KeepAspectRatio, Qt::SmoothTransformation) : fullimage;
 				if (downscaled) {
+					// A huge paste/screenshot doesn't have to be
+					// smooth-scanned three times (medium / full /
+					// thumbnail), produce the limited size once and
+					// derive the smaller sizes from it.
+					fullimage = full;
 					fullimagebytes = fullimageformat = QByteArray();
 				}
+				auto medium = (full.width() > 320 || full.height() > 320) ? full.scaled(320, 320, Qt::KeepAspectRatio, Qt::SmoothTransformation) : full;
 				filedata = ComputePhotoJpegBytes(full, fullimagebytes, fullimageformat);
 
 				photoThumbs.emplace('m', PreparedPhotoThumb{ .image = medium });
@@ -10,6 +10,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/variant.h"
 #include "api/api_common.h"
 
+#include <QtCore/QThread>
+
 namespace Ui {
 struct PreparedFileInformation;
 } // namespace Ui
@@ -91,11 +93,14 @@ class TaskQueue : public QObject {
 	Q_OBJECT
 
 public:
-	explicit TaskQueue(crl::time stopTimeoutMs = 0); // <= 0 - never stop worker
+	explicit TaskQueue(
+		crl::time stopTimeoutMs = 0, // <= 0 - never stop worker
+		QThread::Priority priority = QThread::InheritPriority);
 
 	TaskId addTask(std::unique_ptr<Task> &&task);
 	void addTasks(std::vector<std::unique_ptr<Task>> &&tasks);
 	void cancelTask(TaskId id); // this task finish() won't be called
+	[[nodiscard]] int queueDepth();
 
 	~TaskQueue();
 
@@ -116,6 +121,7 @@ private:
 	TaskId _taskInProcessId = TaskId();
 	QMutex _tasksToProcessMutex, _tasksToFinishMutex;
 	QThread *_thread = nullptr;
+	QThread::Priority _priority = QThread::InheritPriority;
 	TaskQueueWorker *_worker = nullptr;
 	QTimer *_stopTimer = nullptr;
 
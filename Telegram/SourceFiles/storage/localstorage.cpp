@@ -12,6 +12,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "storage/storage_account.h"
 #include "storage/details/storage_file_utilities.h"
 #include "storage/details/storage_settings_scheme.h"
+#include "storage/details/storage_startup_prefetch.h"
 #include "data/data_session.h"
 #include "data/data_document.h"
 #include "data/data_document_media.h"
@@ -355,11 +356,19 @@ void readLangPack();
 void start() {
 	Expects(_basePath.isEmpty());
 
-	_localLoader = new TaskQueue(kFileLoaderQueueStopTimeout);
+	// Waveform counting and the like, should not compete for CPU with
+	// the user-initiated work, so the worker runs at low priority.
+	_localLoader = new TaskQueue(
+		kFileLoaderQueueStopTimeout,
+		QThread::LowPriority);
 
 	_basePath = cWorkingDir() + u"tdata/"_q;
 	if (!QDir().exists(_basePath)) QDir().mkpath(_basePath);
 
+	// Warm the page cache with last start's read set while we still
+	// parse the settings, the account map reads below then hit memory.
+	Storage::details::StartPrefetch(_basePath);
+
 	_oldKotatoVersion = readKotatoVersion();
 	writeKotatoVersion(AppKotatoVersion);
 
@@ -836,6 +845,11 @@ public:
 			if (!_waveform.isEmpty()) {
 				voice->waveform = _waveform;
 				voice->wavemax = _wavemax;
+				_doc->owner().cache().put(
+					_doc->waveformCacheKey(),
+					Storage::Cache::Database::TaggedValue(
+						documentWaveformEncode5bit(_waveform),
+						Data::kVoiceMessageCacheTag));
 			}
 			if (voice->waveform.isEmpty()) {
 				voice->waveform.resize(1);
@@ -869,9 +883,39 @@ void countVoiceWaveform(not_null<Data::DocumentMedia*> media) {
 		if (_localLoader) {
 			voice->waveform.resize(1 + sizeof(TaskId));
 			voice->waveform[0] = -1; // counting
-			TaskId taskId = _localLoader->addTask(
-				std::make_unique<CountWaveformTask>(media));
+			auto taskId = TaskId();
 			memcpy(voice->waveform.data() + 1, &taskId, sizeof(taskId));
+
+			// Look the waveform up in the media cache first, decoding
+			// the whole file is needed only once per document.
+			const auto guard = base::make_weak(&document->session());
+			const auto shared = document->createMediaView();
+			document->owner().cache().get(document->waveformCacheKey(), [=](
+					QByteArray &&value) {
+				auto cached = documentWaveformDecode(value);
+				crl::on_main(guard, [=, cached = std::move(cached)]() mutable {
+					const auto voice = document->voice();
+					if (!voice
+						|| voice->waveform.isEmpty()
+						|| voice->waveform[0] != -1) {
+						return;
+					} else if (!cached.isEmpty()) {
+						voice->waveform = std::move(cached);
+						voice->wavemax = *ranges::max_element(
+							voice->waveform);
+						document->owner().requestDocumentViewRepaint(
+							document);
+					} else if (_localLoader) {
+						const auto taskId = _localLoader->addTask(
+							std::make_unique<CountWaveformTask>(
+								shared.get()));
+						memcpy(
+							voice->waveform.data() + 1,
+							&taskId,
+							sizeof(taskId));
+					}
+				});
+			});
 		}
 	}
 }
@@ -26,4 +26,25 @@ QColor readColor(QDataStream &stream) {
 		int((value >> 24) & 0xFFU));
 }
 
+void writeCompressedBlock(
+		QDataStream &stream,
+		Fn<void(QDataStream &stream)> serializer) {
+	auto serialized = QByteArray();
+	{
+		QDataStream payload(&serialized, QIODevice::WriteOnly);
+		payload.setVersion(stream.version());
+		serializer(payload);
+	}
+	stream << qCompress(serialized, 9);
+}
+
+QByteArray readCompressedBlock(QDataStream &stream) {
+	auto compressed = QByteArray();
+	stream >> compressed;
+	if (stream.status() != QDataStream::Ok || compressed.isEmpty()) {
+		return QByteArray();
+	}
+	return qUncompress(compressed);
+}
+
 } // namespace Serialize
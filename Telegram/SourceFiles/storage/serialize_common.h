@@ -33,6 +33,15 @@ inline int colorSize() {
 void writeColor(QDataStream &stream, const QColor &color);
 QColor readColor(QDataStream &stream);
 
+// Deflated sub-blocks for bulky records (documents, peers, stickers).
+// The payload is serialized into its own buffer and compressed before
+// being written as a single byte array, the reader inflates it and
+// parses the payload from the returned buffer.
+void writeCompressedBlock(
+	QDataStream &stream,
+	Fn<void(QDataStream &stream)> serializer);
+[[nodiscard]] QByteArray readCompressedBlock(QDataStream &stream);
+
 struct ReadBytesVectorWrap {
 	bytes::vector &bytes;
 };
@@ -12,6 +12,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "storage/storage_encryption.h"
 #include "storage/storage_clear_legacy.h"
 #include "storage/cache/storage_cache_types.h"
+#include "storage/details/storage_append_journal.h"
 #include "storage/details/storage_file_utilities.h"
 #include "storage/details/storage_settings_scheme.h"
 #include "storage/serialize_common.h"
@@ -27,6 +28,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "core/core_settings.h"
 #include "core/file_location.h"
+#include "core/tracepoints.h"
 #include "data/stickers/data_stickers.h"
 #include "data/data_session.h"
 #include "data/data_document.h"
@@ -35,6 +37,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "export/export_settings.h"
 #include "window/themes/window_theme.h"
 
+#include <xxhash.h> // XXH64.
+
 namespace Storage {
 namespace {
 
@@ -42,9 +46,14 @@ using namespace details;
 using Database = Cache::Database;
 
 constexpr auto kDelayedWriteTimeout = crl::time(1000);
+constexpr auto kMaintenanceEach = 60 * crl::time(1000);
+constexpr auto kMaintenanceIdleDuration = 5 * 60 * crl::time(1000);
+constexpr auto kMaintenanceBatchSize = 64;
+constexpr auto kDraftCursorsCompactFrom = 256;
 
 constexpr auto kStickersVersionTag = quint32(-1);
-constexpr auto kStickersSerializeVersion = 3;
+constexpr auto kStickersSerializeVersion = 4;
+constexpr auto kStickersUncompressedVersion = 3;
 constexpr auto kMaxSavedStickerSetsCount = 1000;
 constexpr auto kDefaultStickerInstallDate = TimeId(1);
 
@@ -132,15 +141,26 @@ Account::Account(not_null<Main::Account*> owner, const QString &dataName)
 , _basePath(BaseGlobalPath() + ToFilePart(_dataNameKey) + QChar('/'))
 , _tempPath(BaseGlobalPath() + "temp_" + _dataName + QChar('/'))
 , _databasePath(ComputeDatabasePath(dataName))
+, _draftCursorsJournal(
+	std::make_unique<details::AppendJournal>(u"cursors"_q, _basePath))
 , _cacheTotalSizeLimit(Database::Settings().totalSizeLimit)
 , _cacheBigFileTotalSizeLimit(Database::Settings().totalSizeLimit)
 , _cacheTotalTimeLimit(Database::Settings().totalTimeLimit)
 , _cacheBigFileTotalTimeLimit(Database::Settings().totalTimeLimit)
 , _writeMapTimer([=] { writeMap(); })
-, _writeLocationsTimer([=] { writeLocations(); }) {
+, _writeLocationsTimer([=] { writeLocations(); })
+, _writeRecentStickersTimer([=] { writeRecentStickers(); })
+, _writeRecentHashtagsAndBotsTimer([=] { writeRecentHashtagsAndBots(); })
+, _maintenanceTimer([=] { checkMaintenance(); }) {
 }
 
 Account::~Account() {
+	if (_localKey && _recentStickersChanged) {
+		writeRecentStickers();
+	}
+	if (_localKey && _recentHashtagsAndBotsChanged) {
+		writeRecentHashtagsAndBots();
+	}
 	if (_localKey && _mapChanged) {
 		writeMap();
 	}
@@ -167,6 +187,7 @@ std::unique_ptr<MTP::Config> Account::start(MTP::AuthKeyPtr localKey) {
 	_localKey = std::move(localKey);
 	readMapWith(_localKey);
 	clearLegacyFiles();
+	_maintenanceTimer.callEach(kMaintenanceEach);
 	return readMtpConfig();
 }
 
@@ -482,6 +503,8 @@ void Account::writeMapQueued() {
 void Account::writeMap() {
 	Expects(_localKey != nullptr);
 
+	TRACE_SCOPE("Storage::Account::writeMap");
+
 	_writeMapTimer.cancel();
 	if (!_mapChanged) {
 		return;
@@ -607,6 +630,12 @@ void Account::reset() {
 	auto names = collectGoodNames();
 	_draftsMap.clear();
 	_draftCursorsMap.clear();
+	_draftCursorsCache.clear();
+	_draftCursorsJournalLoaded = true;
+	if (_localKey) {
+		EncryptedDescriptor empty;
+		_draftCursorsJournal->compact(empty, _localKey);
+	}
 	_draftsNotReadMap.clear();
 	_locationsKey = _trustedBotsKey = 0;
 	_recentStickersKeyOld = 0;
@@ -624,6 +653,7 @@ void Account::reset() {
 	_archivedCustomEmojiKey = 0;
 	_legacyBackgroundKeyDay = _legacyBackgroundKeyNight = 0;
 	_settingsKey = _recentHashtagsAndBotsKey = _exportSettingsKey = 0;
+	_writtenSessionSettingsHash = 0;
 	_oldMapVersion = 0;
 	_fileLocations.clear();
 	_fileLocationPairs.clear();
@@ -745,6 +775,48 @@ void Account::writeLocationsDelayed() {
 	_writeLocationsTimer.callOnce(kDelayedWriteTimeout);
 }
 
+void Account::checkMaintenance() {
+	// The file locations map keeps entries for files that were removed
+	// from disk behind our back until the exact location is read again,
+	// so without maintenance it only shrinks on restart. Scan it in
+	// small batches while the user is away from the machine.
+	const auto idle = crl::now() - Core::App().lastNonIdleTime();
+	if (idle >= kMaintenanceIdleDuration) {
+		compactFileLocations();
+	}
+}
+
+void Account::compactFileLocations() {
+	if (_fileLocations.isEmpty()) {
+		_maintenanceIndex = 0;
+		return;
+	} else if (_maintenanceIndex >= _fileLocations.size()) {
+		_maintenanceIndex = 0;
+	}
+
+	// One small batch of file checks per pass keeps the I/O negligible,
+	// the index checkpoint resumes the scan on the next idle minute.
+	auto checked = 0;
+	auto removed = 0;
+	auto i = std::next(_fileLocations.begin(), _maintenanceIndex);
+	while (i != _fileLocations.end() && checked != kMaintenanceBatchSize) {
+		++checked;
+		if (!i.value().inMediaCache() && !i.value().check()) {
+			_fileLocationPairs.remove(i.value().fname);
+			i = _fileLocations.erase(i);
+			++removed;
+		} else {
+			++i;
+		}
+	}
+	_maintenanceIndex += checked - removed;
+	if (removed > 0) {
+		DEBUG_LOG(("Storage Info: Dropped %1 dead file locations "
+			"of %2 checked.").arg(removed).arg(checked));
+		writeLocationsDelayed();
+	}
+}
+
 void Account::readLocations() {
 	FileReadDescriptor locations;
 	if (!ReadEncryptedFile(locations, _locationsKey, _basePath, _localKey)) {
@@ -868,6 +940,15 @@ void Account::writeSessionSettings(Main::SessionSettings *stored) {
 	}
 	data.stream << quint32(dbiRecentStickers) << recentStickers;
 
+	// The settings are saved delayed from many unrelated places, often
+	// ending up with exactly the bytes already on disk, so skip the
+	// encrypt+write when the serialized payload didn't change.
+	const auto hash = XXH64(data.data.constData(), data.data.size(), 0);
+	if (hash == _writtenSessionSettingsHash) {
+		return;
+	}
+	_writtenSessionSettingsHash = hash;
+
 	FileWriteDescriptor file(_settingsKey, _basePath);
 	file.writeEncrypted(data, _localKey);
 }
@@ -1197,11 +1278,23 @@ void Account::writeDraftCursors(not_null<History*> history) {
 		clearDraftCursors(peerId);
 		return;
 	}
-	auto i = _draftCursorsMap.find(peerId);
-	if (i == _draftCursorsMap.cend()) {
-		i = _draftCursorsMap.emplace(peerId, GenerateKey(_basePath)).first;
-		writeMapQueued();
+	if (!_localKey) {
+		return;
 	}
+	loadDraftCursorsJournal();
+
+	// Cursor updates are frequent and tiny, so they go to the journal
+	// as delta records. The legacy per-peer file is dropped on first
+	// write, readers fall back to it only for not-yet-migrated peers.
+	if (const auto i = _draftCursorsMap.find(peerId)
+		; i != _draftCursorsMap.cend()) {
+		ClearKey(i->second, _basePath);
+		_draftCursorsMap.erase(i);
+		writeMapDelayed();
+	}
+
+	auto &cursors = _draftCursorsCache[peerId];
+	cursors.clear();
 
 	auto size = int(sizeof(quint64) * 2
 		+ sizeof(quint32)
@@ -1224,6 +1317,7 @@ void Account::writeDraftCursors(not_null<History*> history) {
 			<< qint32(cursor.position)
 			<< qint32(cursor.anchor)
 			<< qint32(cursor.scroll);
+		cursors.emplace(key, cursor);
 	};
 	EnumerateDrafts(
 		map,
@@ -1231,8 +1325,70 @@ void Account::writeDraftCursors(not_null<History*> history) {
 		sources,
 		writeCallback);
 
-	FileWriteDescriptor file(i->second, _basePath);
-	file.writeEncrypted(data, _localKey);
+	_draftCursorsJournal->append(data, _localKey);
+	compactDraftCursorsJournal();
+}
+
+void Account::loadDraftCursorsJournal() {
+	if (_draftCursorsJournalLoaded || !_localKey) {
+		return;
+	}
+	_draftCursorsJournalLoaded = true;
+	_draftCursorsJournal->enumerate(_localKey, [&](
+			EncryptedDescriptor &record) {
+		while (!record.stream.atEnd()) {
+			quint64 tag = 0, peerSerialized = 0;
+			quint32 count = 0;
+			record.stream >> tag >> peerSerialized >> count;
+			const auto peerId = DeserializePeerId(peerSerialized);
+			if (tag != kMultiDraftCursorsTag || count > 1000) {
+				LOG(("App Error: Bad draft cursors journal record."));
+				return;
+			} else if (!count) {
+				_draftCursorsCache.remove(peerId);
+				continue;
+			}
+			auto &cursors = _draftCursorsCache[peerId];
+			cursors.clear();
+			for (auto i = 0; i != int(count); ++i) {
+				qint64 keyValue = 0;
+				qint32 position = 0, anchor = 0, scroll = Ui::kQFixedMax;
+				record.stream >> keyValue >> position >> anchor >> scroll;
+				cursors.emplace(
+					Data::DraftKey::FromSerialized(keyValue),
+					MessageCursor(position, anchor, scroll));
+			}
+		}
+	});
+}
+
+void Account::compactDraftCursorsJournal() {
+	const auto records = _draftCursorsJournal->recordsCount();
+	if (records < kDraftCursorsCompactFrom
+		|| records < 2 * int(_draftCursorsCache.size())) {
+		return;
+	}
+	auto size = 0;
+	for (const auto &[peerId, cursors] : _draftCursorsCache) {
+		size += int(sizeof(quint64) * 2
+			+ sizeof(quint32)
+			+ (sizeof(qint64) + sizeof(qint32) * 3) * cursors.size());
+	}
+	EncryptedDescriptor data(size);
+	for (const auto &[peerId, cursors] : _draftCursorsCache) {
+		data.stream
+			<< quint64(kMultiDraftCursorsTag)
+			<< SerializePeerId(peerId)
+			<< quint32(cursors.size());
+		for (const auto &[key, cursor] : cursors) {
+			data.stream
+				<< key.serialize()
+				<< qint32(cursor.position)
+				<< qint32(cursor.anchor)
+				<< qint32(cursor.scroll);
+		}
+	}
+	_draftCursorsJournal->compact(data, _localKey);
 }
 
 void Account::clearDraftCursors(PeerId peerId) {
@@ -1242,9 +1398,30 @@ void Account::clearDraftCursors(PeerId peerId) {
 		_draftCursorsMap.erase(i);
 		writeMapDelayed();
 	}
+	loadDraftCursorsJournal();
+	if (_draftCursorsCache.remove(peerId) && _localKey) {
+		// An empty section is a tombstone for the peer.
+		EncryptedDescriptor data(sizeof(quint64) * 2 + sizeof(quint32));
+		data.stream
+			<< quint64(kMultiDraftCursorsTag)
+			<< SerializePeerId(peerId)
+			<< quint32(0);
+		_draftCursorsJournal->append(data, _localKey);
+		compactDraftCursorsJournal();
+	}
 }
 
 void Account::readDraftCursors(PeerId peerId, Data::HistoryDrafts &map) {
+	loadDraftCursorsJournal();
+	if (const auto i = _draftCursorsCache.find(peerId)
+		; i != _draftCursorsCache.cend()) {
+		for (const auto &[key, cursor] : i->second) {
+			if (const auto j = map.find(key); j != end(map)) {
+				j->second->cursor = cursor;
+			}
+		}
+		return;
+	}
 	const auto j = _draftCursorsMap.find(peerId);
 	if (j == _draftCursorsMap.cend()) {
 		return;
@@ -1530,7 +1707,9 @@ void Account::readDraftsWithCursorsLegacy(
 }
 
 bool Account::hasDraftCursors(PeerId peer) {
-	return _draftCursorsMap.contains(peer);
+	loadDraftCursorsJournal();
+	return _draftCursorsCache.contains(peer)
+		|| _draftCursorsMap.contains(peer);
 }
 
 bool Account::hasDraft(PeerId peer) {
@@ -1743,6 +1922,7 @@ void Account::writeStickerSets(
 	quint32 size = sizeof(quint32) + sizeof(qint32) + sizeof(qint32);
 
 	int32 setsCount = 0;
+	auto toWrite = std::vector<not_null<Data::StickersSet*>>();
 	for (const auto &[id, set] : sets) {
 		const auto raw = set.get();
 		auto result = checkSet(*raw);
@@ -1751,6 +1931,7 @@ void Account::writeStickerSets(
 		} else if (result == StickerSetCheckResult::Skip) {
 			continue;
 		}
+		toWrite.push_back(raw);
 
 		// id + accessHash + hash + title + shortName + stickersCount + flags + installDate
 		size += sizeof(quint64) * 3
@@ -1796,18 +1977,14 @@ void Account::writeStickerSets(
 	EncryptedDescriptor data(size);
 	data.stream
 		<< quint32(kStickersVersionTag)
-		<< qint32(kStickersSerializeVersion)
-		<< qint32(setsCount);
-	for (const auto &[id, set] : sets) {
-		auto result = checkSet(*set);
-		if (result == StickerSetCheckResult::Abort) {
-			return;
-		} else if (result == StickerSetCheckResult::Skip) {
-			continue;
+		<< qint32(kStickersSerializeVersion);
+	Serialize::writeCompressedBlock(data.stream, [&](QDataStream &stream) {
+		stream << qint32(setsCount);
+		for (const auto &set : toWrite) {
+			writeStickerSet(stream, *set);
 		}
-		writeStickerSet(data.stream, *set);
-	}
-	data.stream << order;
+		stream << order;
+	});
 
 	FileWriteDescriptor file(stickersKey, _basePath);
 	file.writeEncrypted(data, _localKey);
@@ -1839,10 +2016,27 @@ void Account::readStickerSets(
 	qint32 version = 0;
 	stickers.stream >> versionTag >> version;
 	if (versionTag != kStickersVersionTag
-		|| (version != 2 && version != kStickersSerializeVersion)) {
+		|| (version != 2
+			&& version != kStickersUncompressedVersion
+			&& version != kStickersSerializeVersion)) {
 		// Old data, without sticker set thumbnails.
 		return failed();
 	}
+	if (version == kStickersSerializeVersion) {
+		// The payload is one deflated block, inflate it and parse the
+		// sets from the inflated buffer through the same stream.
+		auto uncompressed = Serialize::readCompressedBlock(stickers.stream);
+		if (uncompressed.isEmpty()) {
+			return failed();
+		}
+		stickers.stream.setDevice(nullptr);
+		stickers.buffer.close();
+		stickers.data = uncompressed;
+		stickers.buffer.setBuffer(&stickers.data);
+		stickers.buffer.open(QIODevice::ReadOnly);
+		stickers.stream.setDevice(&stickers.buffer);
+		stickers.stream.setVersion(QDataStream::Qt_5_1);
+	}
 	qint32 count = 0;
 	stickers.stream >> count;
 	if (!CheckStreamStatus(stickers.stream)
@@ -2119,7 +2313,16 @@ void Account::writeFeaturedCustomEmoji() {
 	}, _owner->session().data().stickers().featuredEmojiSetsOrder());
 }
 
+void Account::writeRecentStickersDelayed() {
+	// Using a sticker bumps it in recents and rewrites the whole set
+	// block, so coalesce the writes when sends come in a quick row.
+	_recentStickersChanged = true;
+	_writeRecentStickersTimer.callOnce(kDelayedWriteTimeout);
+}
+
 void Account::writeRecentStickers() {
+	_writeRecentStickersTimer.cancel();
+	_recentStickersChanged = false;
 	writeStickerSets(_recentStickersKey, [](const Data::StickersSet &set) {
 		if (set.id != Data::Stickers::CloudRecentSetId
 			|| set.stickers.isEmpty()) {
@@ -2481,7 +2684,16 @@ void Account::readSavedGifs() {
 	}
 }
 
+void Account::writeRecentHashtagsAndBotsDelayed() {
+	// Each sent hashtag or used inline bot rewrites the whole encrypted
+	// block, so collapse the bursts coming with quickly sent messages.
+	_recentHashtagsAndBotsChanged = true;
+	_writeRecentHashtagsAndBotsTimer.callOnce(kDelayedWriteTimeout);
+}
+
 void Account::writeRecentHashtagsAndBots() {
+	_writeRecentHashtagsAndBotsTimer.cancel();
+	_recentHashtagsAndBotsChanged = false;
 	const auto &write = cRecentWriteHashtags();
 	const auto &search = cRecentSearchHashtags();
 	const auto &bots = cRecentInlineBots();
@@ -2635,7 +2847,7 @@ void Account::saveRecentSentHashtags(const QString &text) {
 		text);
 	if (result) {
 		cSetRecentWriteHashtags(*result);
-		writeRecentHashtagsAndBots();
+		writeRecentHashtagsAndBotsDelayed();
 	}
 }
 
@@ -2645,7 +2857,7 @@ void Account::saveRecentSearchHashtags(const QString &text) {
 		text);
 	if (result) {
 		cSetRecentSearchHashtags(*result);
-		writeRecentHashtagsAndBots();
+		writeRecentHashtagsAndBotsDelayed();
 	}
 }
 
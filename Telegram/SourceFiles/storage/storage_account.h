@@ -42,6 +42,7 @@ namespace Storage {
 namespace details {
 struct ReadSettingsContext;
 struct FileReadDescriptor;
+class AppendJournal;
 } // namespace details
 
 class EncryptionKey;
@@ -120,6 +121,7 @@ public:
 	void writeInstalledStickers();
 	void writeFeaturedStickers();
 	void writeRecentStickers();
+	void writeRecentStickersDelayed();
 	void writeFavedStickers();
 	void writeArchivedStickers();
 	void writeArchivedMasks();
@@ -141,6 +143,7 @@ public:
 	void readFeaturedCustomEmoji();
 
 	void writeRecentHashtagsAndBots();
+	void writeRecentHashtagsAndBotsDelayed();
 	void readRecentHashtagsAndBots();
 	void saveRecentSentHashtags(const QString &text);
 	void saveRecentSearchHashtags(const QString &text);
@@ -206,6 +209,8 @@ private:
 	void writeLocations();
 	void writeLocationsQueued();
 	void writeLocationsDelayed();
+	void checkMaintenance();
+	void compactFileLocations();
 
 	std::unique_ptr<Main::SessionSettings> readSessionSettings();
 	void writeSessionSettings(Main::SessionSettings *stored);
@@ -216,6 +221,8 @@ private:
 		details::ReadSettingsContext &&context);
 
 	void readDraftCursors(PeerId peerId, Data::HistoryDrafts &map);
+	void loadDraftCursorsJournal();
+	void compactDraftCursorsJournal();
 	void readDraftCursorsLegacy(
 		PeerId peerId,
 		details::FileReadDescriptor &draft,
@@ -259,6 +266,16 @@ private:
 
 	base::flat_map<PeerId, FileKey> _draftsMap;
 	base::flat_map<PeerId, FileKey> _draftCursorsMap;
+
+	// Draft cursors live in an append-only journal: a cursor change
+	// appends one small delta record instead of rewriting a per-peer
+	// blob. The legacy per-peer files are dropped on first write, the
+	// map above only tracks not-yet-migrated ones.
+	std::unique_ptr<details::AppendJournal> _draftCursorsJournal;
+	base::flat_map<
+		PeerId,
+		base::flat_map<Data::DraftKey, MessageCursor>> _draftCursorsCache;
+	bool _draftCursorsJournalLoaded = false;
 	base::flat_map<PeerId, bool> _draftsNotReadMap;
 	base::flat_map<
 		not_null<History*>,
@@ -297,6 +314,8 @@ private:
 	qint32 _cacheTotalTimeLimit = 0;
 	qint32 _cacheBigFileTotalTimeLimit = 0;
 
+	uint64 _writtenSessionSettingsHash = 0;
+
 	base::flat_map<PeerId, base::flags<BotTrustFlag>> _trustedBots;
 	bool _trustedBotsRead = false;
 	bool _readingUserSettings = false;
@@ -306,8 +325,14 @@ private:
 
 	base::Timer _writeMapTimer;
 	base::Timer _writeLocationsTimer;
+	base::Timer _writeRecentStickersTimer;
+	base::Timer _writeRecentHashtagsAndBotsTimer;
+	base::Timer _maintenanceTimer;
+	int _maintenanceIndex = 0;
 	bool _mapChanged = false;
 	bool _locationsChanged = false;
+	bool _recentStickersChanged = false;
+	bool _recentHashtagsAndBotsChanged = false;
 
 };
 
@@ -0,0 +1,184 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "storage/storage_archive_import.h"
+
+#include "core/file_location.h"
+#include "data/data_document.h"
+#include "main/main_session.h"
+#include "storage/storage_account.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+namespace Storage {
+namespace {
+
+constexpr auto kHashChunkSize = qint64(1024 * 1024);
+
+struct ArchiveEntry {
+	QString absolutePath;
+	uint64 documentId = 0;
+	int32 dcId = 0;
+	int64 size = 0;
+	QByteArray sha256;
+	LocationType type = DocumentFileLocation;
+};
+
+[[nodiscard]] LocationType TypeFromMediaType(const QString &mediaType) {
+	// Mirrors DocumentData::locationType() - voice messages and video
+	// files use dedicated location types, everything else (including
+	// round video messages and songs) is a plain document.
+	return (mediaType == u"voice_message"_q)
+		? AudioFileLocation
+		: (mediaType == u"video_file"_q)
+		? VideoFileLocation
+		: DocumentFileLocation;
+}
+
+void CollectEntries(
+		const QJsonValue &value,
+		const QDir &base,
+		std::vector<ArchiveEntry> &to) {
+	if (value.isArray()) {
+		const auto list = value.toArray();
+		for (const auto &item : list) {
+			CollectEntries(item, base, to);
+		}
+		return;
+	} else if (!value.isObject()) {
+		return;
+	}
+	const auto object = value.toObject();
+	const auto id = object.value(
+		u"file_document_id"_q).toString().toULongLong();
+	const auto dcId = object.value(u"file_dc_id"_q).toInt();
+	const auto path = object.value(u"file"_q).toString();
+	if (id != 0 && dcId != 0 && !path.isEmpty()) {
+		auto entry = ArchiveEntry();
+		entry.absolutePath = base.absoluteFilePath(path);
+		entry.documentId = id;
+		entry.dcId = dcId;
+		entry.size = int64(object.value(u"file_size"_q).toDouble());
+		entry.sha256 = object.value(
+			u"file_sha256"_q).toString().toLatin1();
+		entry.type = TypeFromMediaType(
+			object.value(u"media_type"_q).toString());
+		to.push_back(std::move(entry));
+	}
+	for (const auto &nested : object) {
+		if (nested.isObject() || nested.isArray()) {
+			CollectEntries(nested, base, to);
+		}
+	}
+}
+
+[[nodiscard]] bool VerifyContent(
+		const QString &path,
+		int64 size,
+		const QByteArray &sha256) {
+	auto file = QFile(path);
+	if (file.size() != size || !file.open(QIODevice::ReadOnly)) {
+		return false;
+	} else if (sha256.isEmpty()) {
+		// Old archive without checksums, the size check has to do.
+		return true;
+	}
+	auto hash = QCryptographicHash(QCryptographicHash::Sha256);
+	while (!file.atEnd()) {
+		hash.addData(file.read(kHashChunkSize));
+	}
+	return (hash.result().toHex() == sha256);
+}
+
+} // namespace
+
+void ImportArchiveMedia(
+		not_null<Main::Session*> session,
+		const QString &resultJsonPath,
+		Fn<void(ArchiveImportResult)> done) {
+	const auto weak = base::make_weak(session.get());
+	crl::async([=] {
+		auto result = ArchiveImportResult();
+		auto verified = std::vector<ArchiveEntry>();
+		auto file = QFile(resultJsonPath);
+		if (!file.open(QIODevice::ReadOnly)) {
+			result.failed = true;
+		} else {
+			const auto document = QJsonDocument::fromJson(file.readAll());
+			file.close();
+			if (document.isNull()) {
+				result.failed = true;
+			} else {
+				auto entries = std::vector<ArchiveEntry>();
+				CollectEntries(
+					document.object(),
+					QFileInfo(resultJsonPath).dir(),
+					entries);
+
+				// Deduplicated archives reference one file from several
+				// messages, don't hash the same path more than once.
+				auto checked = base::flat_map<QString, bool>();
+				for (auto &entry : entries) {
+					auto i = checked.find(entry.absolutePath);
+					if (i == end(checked)) {
+						if (!QFile::exists(entry.absolutePath)) {
+							++result.missing;
+							continue;
+						}
+						i = checked.emplace(
+							entry.absolutePath,
+							VerifyContent(
+								entry.absolutePath,
+								entry.size,
+								entry.sha256)).first;
+					}
+					if (i->second) {
+						verified.push_back(std::move(entry));
+					} else {
+						++result.mismatched;
+					}
+				}
+			}
+		}
+		crl::on_main(weak, [
+			=,
+			result = result,
+			verified = std::move(verified)]() mutable {
+			auto seen = base::flat_set<MediaKey>();
+			for (const auto &entry : verified) {
+				const auto key = mediaKey(
+					entry.type,
+					entry.dcId,
+					entry.documentId);
+				if (!seen.emplace(key).second) {
+					continue;
+				}
+				session->local().writeFileLocation(
+					key,
+					Core::FileLocation(entry.absolutePath));
+				++result.registered;
+			}
+			DEBUG_LOG(("Archive Import: "
+				"Registered: %1, mismatched: %2, missing: %3, failed: %4."
+				).arg(result.registered
+				).arg(result.mismatched
+				).arg(result.missing
+				).arg(Logs::b(result.failed)));
+			if (done) {
+				done(result);
+			}
+		});
+	});
+}
+
+} // namespace Storage
@@ -0,0 +1,41 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Main {
+class Session;
+} // namespace Main
+
+namespace Storage {
+
+struct ArchiveImportResult {
+	int registered = 0;
+	int mismatched = 0;
+	int missing = 0;
+	bool failed = false;
+
+	[[nodiscard]] int total() const {
+		return registered + mismatched + missing;
+	}
+};
+
+// Mounts an exported archive as a local media seed: reads the machine
+// readable result.json, hash-verifies the media files it references and
+// registers the intact ones as local file locations, so the client
+// treats them as already downloaded instead of refetching from server.
+//
+// Only archives written with file identity metadata (file_document_id /
+// file_dc_id / file_sha256 fields) can be imported, older ones produce
+// an empty result. Verification runs on a background thread, 'done' is
+// called on the main thread.
+void ImportArchiveMedia(
+	not_null<Main::Session*> session,
+	const QString &resultJsonPath,
+	Fn<void(ArchiveImportResult)> done);
+
+} // namespace Storage
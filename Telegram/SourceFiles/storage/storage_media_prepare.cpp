@@ -43,9 +43,12 @@ bool ValidPhotoForAlbum(
 }
 
 bool ValidVideoForAlbum(const PreparedFileInformation::Video &video) {
-	const auto width = video.thumbnail.width();
-	const auto height = video.thumbnail.height();
-	return Ui::ValidateThumbDimensions(width, height);
+	const auto dimensions = video.dimensions.isEmpty()
+		? video.thumbnail.size()
+		: video.dimensions;
+	return Ui::ValidateThumbDimensions(
+		dimensions.width(),
+		dimensions.height());
 }
 
 QSize PrepareShownDimensions(const QImage &preview, int sideLimit) {
@@ -301,7 +304,9 @@ void PrepareDetails(PreparedFile &file, int previewWidth, int sideLimit) {
 		if (ValidVideoForAlbum(*video)) {
 			auto blurred = Images::Blur(
 				Images::Opaque(base::duplicate(video->thumbnail)));
-			file.originalDimensions = video->thumbnail.size();
+			file.originalDimensions = video->dimensions.isEmpty()
+				? video->thumbnail.size()
+				: video->dimensions;
 			file.shownDimensions = PrepareShownDimensions(
 				video->thumbnail,
 				sideLimit);
@@ -37,6 +37,10 @@ struct PreparedFileInformation {
 		bool isWebmSticker = false;
 		bool supportsStreaming = false;
 		crl::time duration = -1;
+
+		// Real video dimensions - the thumbnail render may be capped
+		// to a smaller size for huge clips.
+		QSize dimensions;
 		QImage thumbnail;
 	};
 
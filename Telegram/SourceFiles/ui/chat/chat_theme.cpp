@@ -991,11 +991,13 @@ QImage PrepareBlurredBackground(QImage image) {
 	constexpr auto kSize = 900;
 	constexpr auto kRadius = 24;
 	if (image.width() > kSize || image.height() > kSize) {
+		// The heavy blur that follows hides any sampling artifacts, so
+		// don't pay for an area-averaging scale of a 4K source here.
 		image = image.scaled(
 			kSize,
 			kSize,
 			Qt::KeepAspectRatio,
-			Qt::SmoothTransformation);
+			Qt::FastTransformation);
 	}
 	return Images::BlurLargeImage(std::move(image), kRadius);
 }
@@ -47,10 +47,12 @@ void ValidateUserpicCache(
 	view.paletteVersion = version;
 
 	if (cloud) {
-		view.cached = cloud->scaled(
-			full,
-			Qt::IgnoreAspectRatio,
-			Qt::SmoothTransformation);
+		view.cached = (cloud->size() == full)
+			? *cloud
+			: cloud->scaled(
+				full,
+				Qt::IgnoreAspectRatio,
+				Qt::SmoothTransformation);
 		if (radius >= 0.5) {
 			view.cached = Images::Circle(std::move(view.cached));
 		} else if (radius) { 
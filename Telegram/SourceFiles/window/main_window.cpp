@@ -52,9 +52,51 @@ namespace Window {
 namespace {
 
 constexpr auto kSaveWindowPositionTimeout = crl::time(1000);
+constexpr auto kCounterLayersCacheLimit = 12;
 
 using Core::WindowPosition;
 
+// Unread count storms regenerate the same few overlay icons over and
+// over (each update rasterizes the layer for several sizes), so keep
+// the most recent renders around and reuse them.
+struct CounterLayerCacheEntry {
+	int size = 0;
+	int count = 0;
+	double devicePixelRatio = 0.;
+	QRgb bg = 0;
+	QRgb fg = 0;
+	QImage image;
+};
+std::vector<CounterLayerCacheEntry> CounterLayersCache;
+
+[[nodiscard]] QImage *FindCounterLayerInCache(
+		const CounterLayerArgs &args) {
+	for (auto &entry : CounterLayersCache) {
+		if (entry.size == args.size.value()
+			&& entry.count == args.count.value()
+			&& entry.devicePixelRatio == args.devicePixelRatio
+			&& entry.bg == args.bg.value()->c.rgba()
+			&& entry.fg == args.fg.value()->c.rgba()) {
+			return &entry.image;
+		}
+	}
+	return nullptr;
+}
+
+void AddCounterLayerToCache(const CounterLayerArgs &args, QImage image) {
+	while (CounterLayersCache.size() >= kCounterLayersCacheLimit) {
+		CounterLayersCache.erase(begin(CounterLayersCache));
+	}
+	CounterLayersCache.push_back({
+		.size = args.size.value(),
+		.count = args.count.value(),
+		.devicePixelRatio = args.devicePixelRatio,
+		.bg = args.bg.value()->c.rgba(),
+		.fg = args.fg.value()->c.rgba(),
+		.image = std::move(image),
+	});
+}
+
 [[nodiscard]] QPoint ChildSkip() {
 	const auto skipx = st::defaultDialogRow.padding.left()
 		+ st::defaultDialogRow.photoSize
@@ -241,6 +283,10 @@ QIcon CreateIcon(Main::Session *session, bool returnNullIfDefault) {
 }
 
 QImage GenerateCounterLayer(CounterLayerArgs &&args) {
+	if (const auto cached = FindCounterLayerInCache(args)) {
+		return *cached;
+	}
+
 	// platform/linux/main_window_linux depends on count used the same
 	// way for all the same (count % 1000) values.
 	const auto count = args.count.value();
@@ -315,6 +361,7 @@ QImage GenerateCounterLayer(CounterLayerArgs &&args) {
 	p.drawText(d.size - w - d.delta, d.size - f->height + f->ascent, text);
 	p.end();
 
+	AddCounterLayerToCache(args, result);
 	return result;
 }
 
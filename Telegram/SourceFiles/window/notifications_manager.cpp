@@ -265,7 +265,11 @@ System::SkipState System::computeSkipState(
 
 	if (messageType && notifySettings->muteUnknown(thread)) {
 		return { SkipState::Unknown };
-	} else if (messageType && !notifySettings->isMuted(thread)) {
+	} else if (messageType && !thread->muted()) {
+		// Thread::muted() is compiled by NotifySettings::updateLocal and
+		// the unmute-by-finished timers, so during message storms this is
+		// a single load instead of walking topic -> peer -> default
+		// settings for every incoming message.
 		return withSilent(SkipState::DontSkip);
 	} else if (!notifyBy) {
 		return withSilent(
@@ -911,6 +911,7 @@ void SessionNavigation::showRepliesForMessage(
 	_api.request(base::take(_showingRepliesRequestId)).cancel();
 
 	const auto postPeer = history->peer;
+	const auto started = crl::now();
 	_showingRepliesHistory = history;
 	_showingRepliesRootId = rootId;
 	_showingRepliesRequestId = _api.request(
@@ -919,6 +920,8 @@ void SessionNavigation::showRepliesForMessage(
 			MTP_int(rootId))
 	).done([=](const MTPmessages_DiscussionMessage &result) {
 		_showingRepliesRequestId = 0;
+		DEBUG_LOG(("Replies: Discussion resolved in %1ms."
+			).arg(crl::now() - started));
 		result.match([&](const MTPDmessages_discussionMessage &data) {
 			_session->data().processUsers(data.vusers());
 			_session->data().processChats(data.vchats());